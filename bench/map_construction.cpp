@@ -1,6 +1,11 @@
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <cstdint>
 #include <deque>
 #include <flat_map/flat_map.hpp>
+#include <flat_map/flat_multimap.hpp>
+#include <functional>
+#include <limits>
 #include <map>
 #include <random>
 #include <unordered_map>
@@ -34,4 +39,83 @@ BENCHMARK_TEMPLATE(BM_construct_by_iterator, std::unordered_map<int, int>)->Rang
 BENCHMARK_TEMPLATE(BM_construct_by_iterator, flat_map::flat_map<int, int>)->Range(4, 1 << 18);
 BENCHMARK_TEMPLATE(BM_construct_by_iterator, flat_map::flat_map<int, int, std::less<int>, std::deque<std::pair<int, int>>>)->Range(4, 1 << 18);
 
+// Keys ordered by std::less<> (transparent) are sorted by std::stable_sort, and ones by std::less<Key> by radix sort.
+template <typename C>
+static void BM_construct_large(benchmark::State& state)
+{
+    using K = typename C::key_type;
+    std::vector<std::pair<K, K>> src(static_cast<std::size_t>(state.range(0)));
+    for (auto& [k, v] : src)
+    {
+        k = std::uniform_int_distribution<K>{std::numeric_limits<K>::min(), std::numeric_limits<K>::max()}(rng_state);
+        v = k;
+    }
+
+    for (auto _ : state)
+    {
+        C fm(src.begin(), src.end());
+        benchmark::DoNotOptimize(fm.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_construct_large, flat_map::flat_map<std::uint32_t, std::uint32_t, std::less<>>)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct_large, flat_map::flat_map<std::uint32_t, std::uint32_t>)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct_large, flat_map::flat_map<std::int64_t, std::int64_t, std::less<>>)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct_large, flat_map::flat_map<std::int64_t, std::int64_t>)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct_large, flat_map::flat_multimap<std::int64_t, std::int64_t, std::greater<std::int64_t>>)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+
+template <typename C>
+static void BM_construct_parallel(benchmark::State& state)
+{
+    using K = typename C::key_type;
+    std::vector<std::pair<K, K>> src(static_cast<std::size_t>(state.range(0)));
+    for (auto& [k, v] : src)
+    {
+        k = std::uniform_int_distribution<K>{std::numeric_limits<K>::min(), std::numeric_limits<K>::max()}(rng_state);
+        v = k;
+    }
+
+    for (auto _ : state)
+    {
+        C fm(flat_map::parallel_policy{static_cast<unsigned>(state.range(1))}, src.begin(), src.end());
+        benchmark::DoNotOptimize(fm.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_construct_parallel, flat_map::flat_map<std::int64_t, std::int64_t>)->ArgsProduct({{10000000}, {1, 2, 4, 8, 16}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_construct_parallel, flat_map::flat_map<std::int64_t, std::int64_t, std::less<>>)->ArgsProduct({{10000000}, {1, 2, 4, 8, 16}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Concatenation of range(1) sorted runs, every other of which is in reverse order.
+template <typename C>
+static void BM_construct_runs(benchmark::State& state)
+{
+    using K = typename C::key_type;
+    std::vector<std::pair<K, K>> src(static_cast<std::size_t>(state.range(0)));
+    for (auto& [k, v] : src)
+    {
+        k = std::uniform_int_distribution<K>{std::numeric_limits<K>::min(), std::numeric_limits<K>::max()}(rng_state);
+        v = k;
+    }
+    auto const runs = static_cast<std::size_t>(state.range(1));
+    for (std::size_t r = 0; r < runs; ++r)
+    {
+        auto const first = std::next(src.begin(), static_cast<std::ptrdiff_t>(src.size() * r / runs));
+        auto const last = std::next(src.begin(), static_cast<std::ptrdiff_t>(src.size() * (r + 1) / runs));
+        if (r % 2 == 0) { std::sort(first, last); }
+        else { std::sort(first, last, std::greater<>{}); }
+    }
+
+    for (auto _ : state)
+    {
+        C fm(src.begin(), src.end());
+        benchmark::DoNotOptimize(fm.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_construct_runs, flat_map::flat_map<std::int64_t, std::int64_t>)->ArgsProduct({{1000000}, {1, 2, 16, 256}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_construct_runs, flat_map::flat_map<std::int64_t, std::int64_t, std::less<>>)->ArgsProduct({{1000000}, {1, 2, 16, 256}})->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
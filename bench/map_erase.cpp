@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <flat_map/flat_map.hpp>
+#include <flat_map/flat_multimap.hpp>
+#include <random>
+#include <vector>
+
+static std::mt19937 rng_state{};
+
+inline constexpr std::pair<int64_t, int64_t> range{1 << 12, 1 << 20};
+
+static std::vector<std::pair<int, int>> const v = []
+{
+    std::vector<std::pair<int, int>> v;
+    v.resize(range.second);
+    for (auto& [k, v] : v)
+    {
+        k = std::uniform_int_distribution<int>{}(rng_state);
+        v = std::uniform_int_distribution<int>{}(rng_state);
+    }
+    return v;
+}();
+
+// Erases range(0) / range(1) keys of the elements.
+template <typename C>
+static std::vector<int> erased_keys(C const& c, benchmark::State& state)
+{
+    std::vector<int> keys;
+    for (auto itr = c.begin(); itr != c.end(); ++itr)
+    {
+        if (std::uniform_int_distribution<int64_t>{0, state.range(1) - 1}(rng_state) == 0) { keys.push_back(itr->first); }
+    }
+    std::shuffle(keys.begin(), keys.end(), rng_state);
+    return keys;
+}
+
+template <typename C>
+static void BM_erase_by_key(benchmark::State& state)
+{
+    C const orig(v.begin(), std::next(v.begin(), state.range(0)));
+    auto const keys = erased_keys(orig, state);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto c = orig;
+        state.ResumeTiming();
+
+        for (auto key : keys) { c.erase(key); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_erase_by_key<flat_map::flat_map<int, int>>)->Ranges({{range.first, 1 << 18}, {16, 1024}});
+
+template <typename C>
+static void BM_erase_keys(benchmark::State& state)
+{
+    C const orig(v.begin(), std::next(v.begin(), state.range(0)));
+    auto const keys = erased_keys(orig, state);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto c = orig;
+        state.ResumeTiming();
+
+        c.erase_keys(keys.begin(), keys.end());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_erase_keys<flat_map::flat_map<int, int>>)->Ranges({range, {16, 1024}});
+BENCHMARK(BM_erase_keys<flat_map::flat_multimap<int, int>>)->Ranges({range, {16, 1024}});
+
+BENCHMARK_MAIN();
@@ -1,6 +1,12 @@
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <deque>
+#include <flat_map/chunked_vector.hpp>
 #include <flat_map/flat_map.hpp>
+#include <flat_map/index.hpp>
+#include <flat_map/packed_memory_array.hpp>
+#include <functional>
+#include <limits>
 #include <map>
 #include <random>
 #include <unordered_map>
@@ -59,6 +65,43 @@ BENCHMARK(BM_range_insertion<std::unordered_map<int, int>, 1>)->Ranges({range, r
 BENCHMARK(BM_range_insertion<flat_map::flat_map<int, int>, k_factor>)->Ranges({range, range});
 BENCHMARK(BM_range_insertion<flat_map::flat_map<int, int, std::less<int>, std::deque<std::pair<int, int>>>, k_factor>)->Ranges({range, range});
 
+// Unordered range whose keys mostly follow the existing ones, so that the merge seams are close to the end.
+template <typename C, int k_factor>
+static void BM_tail_range_insertion(benchmark::State& state)
+{
+    std::vector<std::pair<int, int>> lv;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        state.counters["k_factor"] = k_factor;
+
+        auto off = std::uniform_int_distribution<int>{0, range.second}(rng_state);
+        C orig(std::next(v.begin(), off), std::next(v.begin(), off + state.range(0)));
+
+        off = std::uniform_int_distribution<int>{0, range.second}(rng_state);
+        lv.assign(std::next(v.begin(), off), std::next(v.begin(), off + state.range(1)));
+        int64_t const first = std::prev(orig.end())->first - 64;
+        for (auto& [k, v] : lv) { k = static_cast<int>(first + k % (std::numeric_limits<int>::max() - first + 1)); }
+
+        for (auto i = 1; i < k_factor; ++i)
+        {
+            auto fm = orig;
+            benchmark::ClobberMemory();
+
+            state.ResumeTiming();
+            fm.insert(lv.begin(), lv.end());
+            benchmark::ClobberMemory();
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+        orig.insert(lv.begin(), lv.end());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_tail_range_insertion<std::map<int, int>, 1>)->Ranges({range, range});
+BENCHMARK(BM_tail_range_insertion<flat_map::flat_map<int, int>, k_factor>)->Ranges({range, range});
+
 template <typename C, int k_factor>
 static void BM_sorted_range_insertion(benchmark::State& state)
 {
@@ -139,4 +182,137 @@ static void BM_insert_sorted(benchmark::State& state)
 BENCHMARK(BM_insert_sorted<flat_map::flat_map<int, int>, k_factor>)->Ranges({range, range});
 BENCHMARK(BM_insert_sorted<flat_map::flat_map<int, int, std::less<int>, std::deque<std::pair<int, int>>>, k_factor>)->Ranges({range, range});
 
+// Hinted insertion of existing keys, whose hints are off by up to state.range(1) elements.
+template <typename C>
+static void BM_insert_near_hint(benchmark::State& state)
+{
+    auto const n = static_cast<int>(state.range(0));
+    auto const d = static_cast<int>(state.range(1));
+
+    C c;
+    for (auto i = 0; i < n; ++i) { c.emplace_hint(c.end(), i, i); }
+
+    std::vector<std::pair<int, typename C::const_iterator>> probes;
+    for (auto i = 0; i < 1024; ++i)
+    {
+        auto const key = std::uniform_int_distribution<int>{0, n - 1}(rng_state);
+        auto const at = std::clamp(key + std::uniform_int_distribution<int>{-d, d}(rng_state), 0, n);
+        probes.emplace_back(key, std::next(c.cbegin(), at));
+    }
+
+    for (auto _ : state)
+    {
+        for (auto const& [key, hint] : probes) { benchmark::DoNotOptimize(c.try_emplace(hint, key, 0)); }
+    }
+    state.SetItemsProcessed(state.iterations() * probes.size());
+}
+BENCHMARK(BM_insert_near_hint<std::map<int, int>>)->Ranges({{1 << 16, 1 << 16}, {1, 1 << 8}});
+BENCHMARK(BM_insert_near_hint<flat_map::flat_map<int, int>>)->Ranges({{1 << 16, 1 << 16}, {1, 1 << 8}});
+BENCHMARK(BM_insert_near_hint<flat_map::flat_map<int, int, std::less<int>, std::deque<std::pair<int, int>>>>)->Ranges({{1 << 16, 1 << 16}, {1, 1 << 8}});
+
+// Single insertions of random keys one by one, followed by lookups of them.
+template <typename C>
+static void BM_insert_random(benchmark::State& state)
+{
+    C const orig(v.begin(), std::next(v.begin(), state.range(0)));
+    auto const first = std::next(v.begin(), range.second);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto fm = orig;
+        state.ResumeTiming();
+
+        for (auto itr = first; itr != std::next(first, state.range(1)); ++itr) { fm.insert(*itr); }
+        for (auto itr = first; itr != std::next(first, state.range(1)); ++itr) { benchmark::DoNotOptimize(fm.find(itr->first)); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_insert_random<std::map<int, int>>)->Ranges({{1 << 12, 1 << 18}, {1 << 10, 1 << 10}});
+BENCHMARK(BM_insert_random<flat_map::flat_map<int, int>>)->Ranges({{1 << 12, 1 << 18}, {1 << 10, 1 << 10}});
+
+// Insertions of random keys by 8 elements, followed by lookups of them.
+template <typename C>
+static void BM_insert_bursts(benchmark::State& state)
+{
+    C const orig(v.begin(), std::next(v.begin(), state.range(0)));
+    auto const first = std::next(v.begin(), range.second);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto fm = orig;
+        state.ResumeTiming();
+
+        for (auto itr = first; itr != std::next(first, state.range(1)); itr += 8) { fm.insert(itr, std::next(itr, 8)); }
+        for (auto itr = first; itr != std::next(first, state.range(1)); ++itr) { benchmark::DoNotOptimize(fm.find(itr->first)); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_insert_bursts<flat_map::flat_map<int, int>>)->Ranges({{1 << 12, 1 << 18}, {1 << 10, 1 << 10}});
+BENCHMARK(BM_insert_bursts<flat_map::flat_map<int, int, std::less<int>, std::vector<std::pair<int, int>>, flat_map::index::delta<>>>)->Ranges({{1 << 12, 1 << 18}, {1 << 10, 1 << 10}});
+
+// Random single element insertion into a map of 1M+ elements.
+template <typename C>
+static void BM_insert_random_large(benchmark::State& state)
+{
+    std::vector<std::pair<int, int>> src(static_cast<std::size_t>(state.range(0) + state.range(1)));
+    for (auto& [k, v] : src)
+    {
+        k = std::uniform_int_distribution<int>{}(rng_state);
+        v = std::uniform_int_distribution<int>{}(rng_state);
+    }
+    C const orig(src.begin(), std::next(src.begin(), state.range(0)));
+    auto const first = std::next(src.begin(), state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto fm = orig;
+        state.ResumeTiming();
+
+        for (auto itr = first; itr != src.end(); ++itr) { fm.insert(*itr); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_insert_random_large<flat_map::flat_map<int, int>>)->Ranges({{1 << 20, 1 << 22}, {1 << 10, 1 << 10}});
+BENCHMARK(BM_insert_random_large<flat_map::flat_map<int, int, std::less<int>, std::deque<std::pair<int, int>>>>)->Ranges({{1 << 20, 1 << 22}, {1 << 10, 1 << 10}});
+BENCHMARK(BM_insert_random_large<flat_map::flat_map<int, int, std::less<int>, flat_map::packed_memory_array<std::pair<int, int>>>>)->Ranges({{1 << 20, 1 << 22}, {1 << 10, 1 << 10}});
+BENCHMARK(BM_insert_random_large<flat_map::flat_map<int, int, std::less<int>, flat_map::chunked_vector<std::pair<int, int>>>>)->Ranges({{1 << 20, 1 << 22}, {1 << 10, 1 << 10}});
+
+// Counts a stream of keys, each of which repeats about range(1) times.
+static void BM_aggregate_unordered_map(benchmark::State& state)
+{
+    auto const distinct = static_cast<int>(state.range(0) / state.range(1));
+
+    for (auto _ : state)
+    {
+        std::unordered_map<int, int> agg;
+        for (auto itr = v.begin(); itr != std::next(v.begin(), state.range(0)); ++itr) { ++agg[itr->first % distinct]; }
+        flat_map::flat_map<int, int> fm(agg.begin(), agg.end());
+        benchmark::DoNotOptimize(fm);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_aggregate_unordered_map)->Ranges({{1 << 12, 1 << 18}, {1, 64}});
+
+static void BM_aggregate_insert_or_combine(benchmark::State& state)
+{
+    auto const distinct = static_cast<int>(state.range(0) / state.range(1));
+    std::vector<std::pair<int, int>> stream(v.begin(), std::next(v.begin(), state.range(0)));
+    for (auto& [k, v] : stream) { k %= distinct; v = 1; }
+
+    for (auto _ : state)
+    {
+        flat_map::flat_map<int, int> fm;
+        fm.insert_or_combine(stream.begin(), stream.end(), std::plus<>{});
+        benchmark::DoNotOptimize(fm);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_aggregate_insert_or_combine)->Ranges({{1 << 12, 1 << 18}, {1, 64}});
+
 BENCHMARK_MAIN();
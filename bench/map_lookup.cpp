@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <flat_map/chunked_vector.hpp>
+#include <flat_map/flat_map.hpp>
+#include <flat_map/flat_set.hpp>
+#include <flat_map/index.hpp>
+#include <flat_map/tied_sequence.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::mt19937_64 rng_state{};
+
+inline constexpr auto probes = 1 << 10;
+
+template <typename K>
+static std::vector<K> random_keys(std::size_t n)
+{
+    std::vector<K> v(n);
+    for (auto& k : v) { k = std::uniform_int_distribution<K>{}(rng_state); }
+    return v;
+}
+
+// baseline: generic binary search over sorted keys
+template <typename K>
+static void BM_std_lower_bound(benchmark::State& state)
+{
+    auto v = random_keys<K>(state.range(0));
+    std::sort(v.begin(), v.end());
+    auto const keys = random_keys<K>(probes);
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(std::lower_bound(v.begin(), v.end(), key, [](K const& lhs, K const& rhs) { return lhs < rhs; }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_std_lower_bound, std::int32_t)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_std_lower_bound, std::int64_t)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <typename C>
+static void BM_lower_bound(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    std::vector<std::pair<K, K>> v;
+    for (auto const& key : random_keys<K>(state.range(0))) { v.emplace_back(key, key); }
+    C fm(v.begin(), v.end());
+    auto const keys = random_keys<K>(probes);
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(fm.lower_bound(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_lower_bound, flat_map::flat_map<std::int32_t, std::int32_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_lower_bound, flat_map::flat_map<std::int32_t, std::int32_t, std::less<std::int32_t>, flat_map::tied_sequence<std::vector<std::int32_t>, std::vector<std::int32_t>>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_lower_bound, flat_map::flat_map<std::int64_t, std::int64_t, std::less<std::int64_t>, flat_map::tied_sequence<std::vector<std::int64_t>, std::vector<std::int64_t>>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_lower_bound, flat_map::flat_map<std::int64_t, std::int64_t, std::less<>, flat_map::tied_sequence<std::vector<std::int64_t>, std::vector<std::int64_t>>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <typename C>
+static void BM_set_lower_bound(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    auto const v = random_keys<K>(state.range(0));
+    C fs(v.begin(), v.end());
+    auto const keys = random_keys<K>(probes);
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(fs.lower_bound(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_set_lower_bound, flat_map::flat_set<std::int32_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound, flat_map::flat_set<std::int64_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <typename C>
+static void BM_find_loop(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    std::vector<std::pair<K, K>> v;
+    for (auto const& key : random_keys<K>(state.range(0))) { v.emplace_back(key, key); }
+    C fm(v.begin(), v.end());
+    fm.freeze();
+    auto const keys = random_keys<K>(probes);
+    std::vector<typename C::iterator> found(probes);
+
+    for (auto _ : state)
+    {
+        auto out = found.begin();
+        for (auto const& key : keys) { *out++ = fm.find(key); }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_find_loop, flat_map::flat_map<std::int64_t, std::int64_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_find_loop, flat_map::flat_map<std::int64_t, std::int64_t, std::less<std::int64_t>, std::vector<std::pair<std::int64_t, std::int64_t>>, flat_map::index::hashed>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_find_loop, flat_map::flat_map<std::int64_t, std::int64_t, std::less<std::int64_t>, std::deque<std::pair<std::int64_t, std::int64_t>>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_find_loop, flat_map::flat_map<std::int64_t, std::int64_t, std::less<std::int64_t>, flat_map::chunked_vector<std::pair<std::int64_t, std::int64_t>>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <typename C>
+static void BM_find_many(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    std::vector<std::pair<K, K>> v;
+    for (auto const& key : random_keys<K>(state.range(0))) { v.emplace_back(key, key); }
+    C fm(v.begin(), v.end());
+    auto const keys = random_keys<K>(probes);
+    std::vector<typename C::iterator> found(probes);
+
+    for (auto _ : state)
+    {
+        fm.find_many(keys.begin(), keys.end(), found.begin());
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_find_many, flat_map::flat_map<std::int64_t, std::int64_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <typename C>
+static void BM_find_many_sorted(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    std::vector<std::pair<K, K>> v;
+    for (auto const& key : random_keys<K>(state.range(0))) { v.emplace_back(key, key); }
+    C fm(v.begin(), v.end());
+    auto keys = random_keys<K>(probes);
+    std::sort(keys.begin(), keys.end());
+    std::vector<typename C::iterator> found(probes);
+
+    for (auto _ : state)
+    {
+        fm.find_many(flat_map::range_order::sorted, keys.begin(), keys.end(), found.begin());
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_find_many_sorted, flat_map::flat_map<std::int64_t, std::int64_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+// Replays stored keys in ascending order, one lookup at a time.
+template <typename C, bool UseCursor>
+static void BM_find_monotone(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    std::vector<std::pair<K, K>> v;
+    for (auto const& key : random_keys<K>(state.range(0))) { v.emplace_back(key, key); }
+    C fm(v.begin(), v.end());
+    std::vector<K> keys;
+    for (auto i = 0; i < probes; ++i) { keys.push_back(v[std::uniform_int_distribution<std::size_t>{0, v.size() - 1}(rng_state)].first); }
+    std::sort(keys.begin(), keys.end());
+
+    for (auto _ : state)
+    {
+        if constexpr (UseCursor)
+        {
+            auto cursor = fm.make_cursor();
+            for (auto const& key : keys) { benchmark::DoNotOptimize(cursor.find(key)); }
+        }
+        else
+        {
+            for (auto const& key : keys) { benchmark::DoNotOptimize(fm.find(key)); }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_find_monotone, flat_map::flat_map<std::int64_t, std::int64_t>, false)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_find_monotone, flat_map::flat_map<std::int64_t, std::int64_t>, true)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+enum class distribution { uniform, skewed, sequential };
+
+template <typename K, distribution D>
+static std::vector<K> distributed_keys(std::size_t n)
+{
+    std::vector<K> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        switch (D)
+        {
+        case distribution::uniform:
+            v[i] = std::uniform_int_distribution<K>{}(rng_state);
+            break;
+
+        case distribution::skewed:
+            v[i] = static_cast<K>(std::exp(std::normal_distribution<double>{0, 4}(rng_state)) * 1e6);
+            break;
+
+        case distribution::sequential:
+            // monotonically assigned IDs with occasional gaps
+            v[i] = static_cast<K>(i * 4 + (i / 1000) * 1000);
+            break;
+        }
+    }
+    return v;
+}
+
+template <typename K, distribution D>
+static void BM_std_lower_bound_distribution(benchmark::State& state)
+{
+    auto v = distributed_keys<K, D>(state.range(0));
+    std::sort(v.begin(), v.end());
+    std::vector<K> keys;
+    for (auto i = 0; i < probes; ++i) { keys.push_back(v[std::uniform_int_distribution<std::size_t>{0, v.size() - 1}(rng_state)]); }
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(std::lower_bound(v.begin(), v.end(), key, [](K const& lhs, K const& rhs) { return lhs < rhs; }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_std_lower_bound_distribution, std::int64_t, distribution::uniform)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_std_lower_bound_distribution, std::int64_t, distribution::skewed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_std_lower_bound_distribution, std::int64_t, distribution::sequential)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <typename C, distribution D>
+static void BM_set_lower_bound_distribution(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    auto const v = distributed_keys<K, D>(state.range(0));
+    C fs(v.begin(), v.end());
+    fs.freeze();
+    std::vector<K> keys;
+    for (auto i = 0; i < probes; ++i) { keys.push_back(v[std::uniform_int_distribution<std::size_t>{0, v.size() - 1}(rng_state)]); }
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(fs.lower_bound(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, flat_map::flat_set<std::int64_t>, distribution::uniform)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, flat_map::flat_set<std::int64_t>, distribution::skewed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, flat_map::flat_set<std::int64_t>, distribution::sequential)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+template <std::size_t Epsilon>
+using learned_set = flat_map::flat_set<std::int64_t, std::less<std::int64_t>, std::vector<std::int64_t>, flat_map::index::learned<Epsilon>>;
+
+// error bound tuning
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<8>, distribution::uniform)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<8>, distribution::skewed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<8>, distribution::sequential)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<32>, distribution::uniform)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<32>, distribution::skewed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<32>, distribution::sequential)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<128>, distribution::uniform)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<128>, distribution::skewed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, learned_set<128>, distribution::sequential)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+using interpolation_set = flat_map::flat_set<std::int64_t, std::less<std::int64_t>, std::vector<std::int64_t>, flat_map::index::interpolation<>>;
+
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, interpolation_set, distribution::uniform)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, interpolation_set, distribution::skewed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_set_lower_bound_distribution, interpolation_set, distribution::sequential)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+// 1% of keys receive 60% of lookups.
+template <typename C>
+static void BM_find_hot_keys(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    auto const v = random_keys<K>(state.range(0));
+    C fs(v.begin(), v.end());
+    fs.freeze();
+    auto const hot = std::max<std::size_t>(v.size() / 100, 1);
+    std::vector<K> keys;
+    for (auto i = 0; i < probes; ++i)
+    {
+        auto const n = std::bernoulli_distribution{0.6}(rng_state) ? hot : v.size();
+        keys.push_back(v[std::uniform_int_distribution<std::size_t>{0, n - 1}(rng_state)]);
+    }
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(fs.find(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_find_hot_keys, flat_map::flat_set<std::int64_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_find_hot_keys, flat_map::flat_set<std::int64_t, std::less<std::int64_t>, std::vector<std::int64_t>, flat_map::index::memoized<>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_find_hot_keys, flat_map::flat_set<std::int64_t, std::less<std::int64_t>, std::vector<std::int64_t>, flat_map::index::hashed>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+// 90% of lookups miss.
+template <typename C>
+static void BM_contains_misses(benchmark::State& state)
+{
+    using K = typename C::key_type;
+
+    auto const v = random_keys<K>(state.range(0));
+    C fs(v.begin(), v.end());
+    fs.freeze();
+    auto keys = random_keys<K>(probes);
+    for (auto i = 0; i < probes / 10; ++i) { keys[i] = v[std::uniform_int_distribution<std::size_t>{0, v.size() - 1}(rng_state)]; }
+    std::shuffle(keys.begin(), keys.end(), rng_state);
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(fs.contains(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_contains_misses, flat_map::flat_set<std::uint64_t>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_contains_misses, flat_map::flat_set<std::uint64_t, std::less<std::uint64_t>, std::vector<std::uint64_t>, flat_map::index::bloom<>>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+
+static std::vector<std::string> random_paths(std::size_t n)
+{
+    std::vector<std::string> v(n);
+    for (auto& s : v)
+    {
+        s = "https://example.com/";
+        for (auto i = 0; i < 3; ++i) { s += std::to_string(std::uniform_int_distribution<int>{0, 9999}(rng_state)) + '/'; }
+    }
+    return v;
+}
+
+template <typename C>
+static void BM_find_string(benchmark::State& state)
+{
+    std::vector<std::pair<std::string, int>> v;
+    for (auto const& key : random_paths(state.range(0))) { v.emplace_back(key, 0); }
+    C fm(v.begin(), v.end());
+    fm.freeze();
+    std::vector<std::string> keys;
+    for (auto i = 0; i < probes; ++i) { keys.push_back(v[std::uniform_int_distribution<std::size_t>{0, v.size() - 1}(rng_state)].first); }
+
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(fm.find(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * probes);
+}
+BENCHMARK_TEMPLATE(BM_find_string, flat_map::flat_map<std::string, int>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_find_string, flat_map::flat_map<std::string, int, std::less<std::string>, std::vector<std::pair<std::string, int>>, flat_map::index::prefix>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,475 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "flat_map/__comparator.hpp"
+#include "flat_map/__memory.hpp"
+
+namespace flat_map::detail
+{
+
+template <typename Key, typename Compare>
+inline constexpr bool is_branchless_comparable_v = std::is_arithmetic_v<Key> && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::greater<Key>>);
+
+// True for keys ordered before `key`, and also for equivalent keys if Upper.
+template <typename K, typename Compare, bool Upper>
+struct bound_predicate
+{
+    K const& key;
+    Compare const& comp;
+
+    template <typename T>
+    bool operator()(T const& x) const
+    {
+        if constexpr (Upper) { return !invoke_less(comp, key, x); }
+        else { return invoke_less(comp, x, key); }
+    }
+};
+
+// Distance from `from` to `to` (>= from) as floating point, without overflow of integral keys.
+template <typename Key>
+double key_distance(Key const& from, Key const& to) noexcept
+{
+    if constexpr (std::is_integral_v<Key> && !std::is_same_v<Key, bool>)
+    {
+        using unsigned_type = std::make_unsigned_t<Key>;
+        return static_cast<double>(static_cast<unsigned_type>(static_cast<unsigned_type>(to) - static_cast<unsigned_type>(from)));
+    }
+    else
+    {
+        return static_cast<double>(to) - static_cast<double>(from);
+    }
+}
+
+// fmix64 of MurmurHash3, since std::hash of integers might be identity.
+template <typename Key>
+std::uint64_t mixed_hash(Key const& key) noexcept(noexcept(std::hash<Key>{}(key)))
+{
+    auto h = static_cast<std::uint64_t>(std::hash<Key>{}(key));
+    h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdull;
+    h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53ull;
+    return h ^ (h >> 33);
+}
+
+template <typename T, typename = void>
+struct is_byte_string : std::false_type {};
+
+template <typename T>
+struct is_byte_string<T, std::void_t<typename T::traits_type, decltype(std::string_view{std::declval<T const&>()})>> : std::is_same<typename T::traits_type, std::char_traits<char>> {};
+
+// Big endian integer of the first 8 bytes padded with zeros, ordered as same as the strings unless equal.
+inline std::uint64_t string_prefix(std::string_view s) noexcept
+{
+    std::uint64_t p = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        p = (p << 8) | (i < s.size() ? static_cast<unsigned char>(s[i]) : 0u);
+    }
+    return p;
+}
+
+template <typename T>
+struct is_pointer_tuple : std::false_type {};
+
+template <typename... Ts>
+struct is_pointer_tuple<std::tuple<Ts*...>> : std::true_type {};
+
+// Returns the pointer to the keys and the projection from its element to the key.
+// The keys of tied_sequence are the first column, otherwise the elements hold keys.
+template <typename Container, typename KeyExtractor>
+auto key_column(Container& cont, KeyExtractor extract) noexcept
+{
+    auto p = cont.data();
+    if constexpr (is_pointer_tuple<decltype(p)>::value)
+    {
+        return std::pair{std::get<0>(p), [](auto const& key) -> auto& { return key; }};
+    }
+    else
+    {
+        return std::pair{p, extract};
+    }
+}
+
+// Branchless variant of std::partition_point over [first, first + n).
+// Every iteration halves the range with a conditional move instead of a branch, and both candidates of the next probe are prefetched.
+template <typename Pointer, typename Proj, typename Pred>
+std::size_t branchless_partition_point(Pointer first, std::size_t n, Proj proj, Pred pred)
+{
+    if (n == 0) { return 0; }
+
+    auto base = first;
+    while (n > 1)
+    {
+        auto const half = n / 2;
+        prefetch(base + half / 2);
+        prefetch(base + half + half / 2);
+        base += static_cast<std::size_t>(pred(proj(base[half]))) * half;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - first) + static_cast<std::size_t>(pred(proj(*base)));
+}
+
+// Vector comparison of signed integers, selected by the target ISA at compile time.
+template <std::size_t Size, typename = void>
+struct simd_ops
+{
+    static constexpr std::size_t lanes = 1;
+};
+
+#if defined(__AVX2__)
+template <std::size_t Size>
+struct simd_ops<Size, std::enable_if_t<Size == 4 || Size == 8>>
+{
+    static constexpr std::size_t lanes = 32 / Size;
+
+    using lane_type = std::conditional_t<Size == 4, std::int32_t, std::int64_t>;
+    using vector_type = __m256i;
+
+    static vector_type set1(lane_type v) noexcept
+    {
+        if constexpr (Size == 4) { return _mm256_set1_epi32(v); }
+        else { return _mm256_set1_epi64x(v); }
+    }
+    static vector_type load(void const* p) noexcept { return _mm256_loadu_si256(static_cast<vector_type const*>(p)); }
+    static vector_type bitwise_xor(vector_type a, vector_type b) noexcept { return _mm256_xor_si256(a, b); }
+    static vector_type cmpgt(vector_type a, vector_type b) noexcept
+    {
+        if constexpr (Size == 4) { return _mm256_cmpgt_epi32(a, b); }
+        else { return _mm256_cmpgt_epi64(a, b); }
+    }
+    static unsigned mask(vector_type m) noexcept
+    {
+        if constexpr (Size == 4) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+        else { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(m))); }
+    }
+};
+#elif defined(__SSE2__)
+template <std::size_t Size>
+#if defined(__SSE4_2__)
+struct simd_ops<Size, std::enable_if_t<Size == 4 || Size == 8>>
+#else
+struct simd_ops<Size, std::enable_if_t<Size == 4>>
+#endif
+{
+    static constexpr std::size_t lanes = 16 / Size;
+
+    using lane_type = std::conditional_t<Size == 4, std::int32_t, std::int64_t>;
+    using vector_type = __m128i;
+
+    static vector_type set1(lane_type v) noexcept
+    {
+        if constexpr (Size == 4) { return _mm_set1_epi32(v); }
+        else { return _mm_set1_epi64x(v); }
+    }
+    static vector_type load(void const* p) noexcept { return _mm_loadu_si128(static_cast<vector_type const*>(p)); }
+    static vector_type bitwise_xor(vector_type a, vector_type b) noexcept { return _mm_xor_si128(a, b); }
+    static vector_type cmpgt(vector_type a, vector_type b) noexcept
+    {
+        if constexpr (Size == 4) { return _mm_cmpgt_epi32(a, b); }
+#if defined(__SSE4_2__)
+        else { return _mm_cmpgt_epi64(a, b); }
+#endif
+    }
+    static unsigned mask(vector_type m) noexcept
+    {
+        if constexpr (Size == 4) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m))); }
+        else { return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(m))); }
+    }
+};
+#endif
+
+template <typename Key, typename Compare>
+inline constexpr bool is_simd_searchable_v = std::is_integral_v<Key> && is_branchless_comparable_v<Key, Compare> && (simd_ops<sizeof(Key)>::lanes > 1);
+
+// Counts keys in [first, first + n) which satisfy `comp(x, key)` (or `!comp(key, x)` if Upper), comparing several keys at once.
+// Since the keys are sorted, the count is the offset of the partition point.
+template <bool Upper, typename Key, typename Compare>
+std::size_t simd_count(Key const* first, std::size_t n, Key const& key, Compare const& comp) noexcept
+{
+    using ops = simd_ops<sizeof(Key)>;
+    using lane_type = typename ops::lane_type;
+
+    // Flipping the sign bit maps the unsigned order onto the signed one.
+    constexpr auto bias = std::is_unsigned_v<Key> ? std::numeric_limits<lane_type>::min() : lane_type{0};
+    constexpr bool greater = std::is_same_v<Compare, std::greater<Key>>;
+
+    auto const b = ops::set1(bias);
+    auto const k = ops::set1(static_cast<lane_type>(static_cast<lane_type>(key) ^ bias));
+
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + ops::lanes <= n; i += ops::lanes)
+    {
+        auto const x = ops::bitwise_xor(ops::load(first + i), b);
+        // x < k, !(x > k), x > k, and !(x < k) respectively.
+        auto const m = greater != Upper ? ops::cmpgt(x, k) : ops::cmpgt(k, x);
+        auto const c = static_cast<std::size_t>(__builtin_popcount(ops::mask(m)));
+        count += Upper ? ops::lanes - c : c;
+    }
+    for (; i < n; ++i)
+    {
+        count += static_cast<std::size_t>(Upper ? !comp(key, first[i]) : comp(first[i], key));
+    }
+    return count;
+}
+
+// k-ary variant of branchless_partition_point for integer keys.
+// The range is halved until it fits in a few vectors, then the rest is resolved by simd_count.
+template <bool Upper, typename Key, typename Compare>
+std::size_t simd_partition_point(Key const* first, std::size_t n, Key const& key, Compare const& comp) noexcept
+{
+    constexpr std::size_t window = simd_ops<sizeof(Key)>::lanes * 2;
+
+    auto base = first;
+    while (n > window)
+    {
+        auto const half = n / 2;
+        prefetch(base + half / 2);
+        prefetch(base + half + half / 2);
+        auto const& x = base[half];
+        base += static_cast<std::size_t>(Upper ? !comp(key, x) : comp(x, key)) * half;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - first) + simd_count<Upper>(base, n, key, comp);
+}
+
+// Counts elements of sorted [first, first + n) satisfying pred, i.e. the offset of the partition point.
+template <typename T, typename Pred>
+std::size_t count_bound(T const* first, std::size_t n, Pred const& pred)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) { count += static_cast<std::size_t>(pred(first[i])); }
+    return count;
+}
+
+template <typename T, typename K, typename Compare, bool Upper>
+std::size_t count_bound(T const* first, std::size_t n, bound_predicate<K, Compare, Upper> const& pred)
+{
+    if constexpr (std::is_same_v<T, K> && is_simd_searchable_v<T, Compare>)
+    {
+        return simd_count<Upper>(first, n, pred.key, pred.comp);
+    }
+    else
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < n; ++i) { count += static_cast<std::size_t>(pred(first[i])); }
+        return count;
+    }
+}
+
+template <typename Key, typename Compare>
+inline constexpr bool is_radix_sortable_v = is_branchless_comparable_v<Key, Compare> && !std::is_same_v<Key, bool> && sizeof(Key) <= sizeof(std::uint64_t) && (std::is_integral_v<Key> || std::numeric_limits<Key>::is_iec559);
+
+template <std::size_t Size>
+using radix_key_t = std::conditional_t<Size == 1, std::uint8_t, std::conditional_t<Size == 2, std::uint16_t, std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+// Maps the key to an unsigned integer in the order of Compare, where equivalent keys are mapped to the same integer.
+template <typename Key, typename Compare>
+radix_key_t<sizeof(Key)> radix_key(Key key) noexcept
+{
+    using U = radix_key_t<sizeof(Key)>;
+    constexpr auto sign = static_cast<U>(U{1} << (sizeof(Key) * 8 - 1));
+    U u;
+    if constexpr (std::is_floating_point_v<Key>)
+    {
+        if (key == Key{}) { key = Key{}; } // -0 is equivalent to +0
+        std::memcpy(&u, &key, sizeof(u));
+        u = (u & sign) ? static_cast<U>(~u) : static_cast<U>(u | sign);
+    }
+    else
+    {
+        u = static_cast<U>(key);
+        if constexpr (std::is_signed_v<Key>) { u ^= sign; }
+    }
+    if constexpr (std::is_same_v<Compare, std::greater<Key>>) { u = static_cast<U>(~u); }
+    return u;
+}
+
+// Depth of the node between adjacent runs [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) in the nearly optimal merge tree of powersort.
+inline std::size_t merge_power(std::size_t n, std::size_t s1, std::size_t n1, std::size_t n2) noexcept
+{
+    // Midpoints of the runs, scaled by 2.
+    auto a = 2 * s1 + n1;
+    auto b = a + n1 + n2;
+    std::size_t power = 0;
+    while (true)
+    {
+        ++power;
+        if (a >= n)
+        {
+            a -= n;
+            b -= n;
+        }
+        else if (b >= n) { break; }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+// Finds ascending runs and strictly descending runs of [first, last), which are reversed, and merges them in the order of powersort, in O(n log k) for k runs.
+// Returns false without modifying the range as soon as there turn out to be more runs than `max_runs`.
+template <typename BidirectionalIterator, typename Compare>
+bool merge_natural_runs(BidirectionalIterator first, BidirectionalIterator last, Compare const& comp, std::size_t max_runs)
+{
+    auto const n = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::size_t> bounds{0};
+    std::vector<bool> descending;
+    for (auto itr = first; itr != last;)
+    {
+        if (bounds.size() > max_runs) { return false; }
+        auto prev = itr++;
+        auto size = bounds.back() + 1;
+        descending.push_back(itr != last && comp(*itr, *prev));
+        if (descending.back()) { for (; itr != last && comp(*itr, *prev); prev = itr++) { ++size; } }
+        else { for (; itr != last && !comp(*itr, *prev); prev = itr++) { ++size; } }
+        bounds.push_back(size);
+    }
+
+    auto run = first;
+    for (std::size_t r = 0; r < descending.size(); ++r)
+    {
+        auto const next = std::next(run, static_cast<typename std::iterator_traits<BidirectionalIterator>::difference_type>(bounds[r + 1] - bounds[r]));
+        if (descending[r]) { std::reverse(run, next); }
+        run = next;
+    }
+    if (bounds.size() <= 2) { return true; }
+
+    auto at = [first](std::size_t i) { return std::next(first, static_cast<typename std::iterator_traits<BidirectionalIterator>::difference_type>(i)); };
+
+    // Runs on the stack with the power to the next run, where the last one ends at the beginning of the current run.
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    auto begin = bounds[0], end = bounds[1];
+    for (std::size_t r = 2; r < bounds.size(); ++r)
+    {
+        auto const power = merge_power(n, begin, end - begin, bounds[r] - end);
+        while (!stack.empty() && stack.back().second > power)
+        {
+            std::inplace_merge(at(stack.back().first), at(begin), at(end), comp);
+            begin = stack.back().first;
+            stack.pop_back();
+        }
+        stack.emplace_back(begin, power);
+        begin = end;
+        end = bounds[r];
+    }
+    for (; !stack.empty(); stack.pop_back())
+    {
+        std::inplace_merge(at(stack.back().first), at(begin), at(end), comp);
+        begin = stack.back().first;
+    }
+    return true;
+}
+
+template <typename U, typename T, typename KeyOf>
+std::array<std::array<std::size_t, 256>, sizeof(U)> radix_counts(T const* first, T const* last, KeyOf const& key)
+{
+    std::array<std::array<std::size_t, 256>, sizeof(U)> counts{};
+    for (auto itr = first; itr != last; ++itr)
+    {
+        auto const k = key(*itr);
+        for (std::size_t d = 0; d < sizeof(U); ++d) { ++counts[d][(k >> (d * 8)) & 0xff]; }
+    }
+    return counts;
+}
+
+template <typename U, typename T, typename KeyOf>
+void radix_scatter(T* from, T* to, std::size_t n, std::size_t d, std::array<std::size_t, 256> const& counts, KeyOf const& key)
+{
+    std::array<std::size_t, 256> offsets;
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b < 256; ++b)
+    {
+        offsets[b] = sum;
+        sum += counts[b];
+    }
+    for (std::size_t i = 0; i < n; ++i) { to[offsets[(key(from[i]) >> (d * 8)) & 0xff]++] = std::move(from[i]); }
+}
+
+// Stable radix sort by bytes of `key(value)` with `scratch` of the same size, which skips the bytes common to all elements.
+// Large range is split by the most significant byte first, so that the rest of passes (LSD) work on a bucket in cache.
+template <typename T, typename KeyOf>
+void radix_sort(T* first, T* last, T* scratch, KeyOf const& key)
+{
+    using U = decltype(key(*first));
+    auto const n = static_cast<std::size_t>(last - first);
+    if (n < 64)
+    {
+        std::stable_sort(first, last, [&](T const& lhs, T const& rhs) { return key(lhs) < key(rhs); });
+        return;
+    }
+
+    auto const counts = radix_counts<U>(first, last, key);
+    std::array<std::size_t, sizeof(U)> passes;
+    std::size_t npasses = 0;
+    auto const k0 = key(*first);
+    for (std::size_t d = 0; d < sizeof(U); ++d)
+    {
+        if (counts[d][(k0 >> (d * 8)) & 0xff] != n) { passes[npasses++] = d; }
+    }
+
+    if (n > (std::size_t{1} << 12) && npasses > 2)
+    {
+        auto const d = passes[--npasses];
+        radix_scatter<U>(first, scratch, n, d, counts[d], key);
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < 256; ++b)
+        {
+            auto const m = counts[d][b];
+            radix_sort(scratch + offset, scratch + offset + m, first + offset, key);
+            offset += m;
+        }
+        std::move(scratch, scratch + n, first);
+        return;
+    }
+
+    for (std::size_t p = 0; p < npasses; ++p)
+    {
+        if (p % 2 == 0) { radix_scatter<U>(first, scratch, n, passes[p], counts[passes[p]], key); }
+        else { radix_scatter<U>(scratch, first, n, passes[p], counts[passes[p]], key); }
+    }
+    if (npasses % 2 == 1) { std::move(scratch, scratch + n, first); }
+}
+
+// `buffer` is a vector of the value type used as scratch space.
+// Elements which aren't default constructible are moved into the buffer and sorted back, so that they are never copied.
+template <typename T, typename Buffer, typename KeyOf>
+void radix_sort(T* first, T* last, Buffer& buffer, KeyOf const& key)
+{
+    if constexpr (std::is_default_constructible_v<T>)
+    {
+        buffer.resize(static_cast<std::size_t>(last - first));
+        radix_sort(first, last, buffer.data(), key);
+    }
+    else
+    {
+        buffer.assign(std::make_move_iterator(first), std::make_move_iterator(last));
+        radix_sort(buffer.data(), buffer.data() + buffer.size(), first, key);
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+}
+
+} // namespace flat_map::detail
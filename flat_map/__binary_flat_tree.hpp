@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <initializer_list>
@@ -12,20 +13,79 @@
 #include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "flat_map/__algorithm.hpp"
 #include "flat_map/__concepts.hpp"
 #include "flat_map/__comparator.hpp"
+#include "flat_map/__parallel.hpp"
+#include "flat_map/__type_traits.hpp"
 #include "flat_map/enum.hpp"
+#include "flat_map/index.hpp"
 
 namespace flat_map::detail
 {
 
-template <typename Subclass, typename Key, typename Compare, typename Container>
-class _binary_flat_tree_base : private detail::comparator_store<Compare>
+template <typename Store>
+struct index_store : private Store
+{
+    auto& _index() const { return *static_cast<Store const*>(this); }
+    auto& _index() { return *static_cast<Store*>(this); }
+};
+
+// First keys of the segments of a segmented container, for the search to find a segment without loading every segment.
+// Copy and move carry the keys as same as the container carries its segments, and the source of move has no keys in sync.
+template <typename Key, typename Container, typename = void>
+struct segment_store
+{
+    static constexpr bool _has_segment_keys = false;
+};
+
+template <typename Key, typename Container>
+struct segment_store<Key, Container, std::enable_if_t<concepts::Segmented<Container> && std::is_copy_constructible_v<Key>>>
+{
+    static constexpr bool _has_segment_keys = true;
+
+    std::vector<Key> _segment_keys;
+    bool _segment_keys_valid = false;
+
+    segment_store() = default;
+    segment_store(segment_store const&) = default;
+    segment_store(segment_store&& other) noexcept
+      : _segment_keys{std::move(other._segment_keys)}, _segment_keys_valid{std::exchange(other._segment_keys_valid, false)} { }
+
+    segment_store& operator=(segment_store const&) = default;
+    segment_store& operator=(segment_store&& other) noexcept
+    {
+        _segment_keys = std::move(other._segment_keys);
+        _segment_keys_valid = std::exchange(other._segment_keys_valid, false);
+        return *this;
+    }
+};
+
+// Counts structural mutations of a container, for cursors to detect that their positions went stale.
+// Copy and move give a fresh count, and the source of move is counted as mutated.
+struct mutation_epoch
+{
+    std::size_t value = 0;
+
+    mutation_epoch() = default;
+    mutation_epoch(mutation_epoch const&) noexcept { }
+    mutation_epoch(mutation_epoch&& other) noexcept { ++other.value; }
+    mutation_epoch& operator=(mutation_epoch const&) noexcept { ++value; return *this; }
+    mutation_epoch& operator=(mutation_epoch&& other) noexcept { ++value; ++other.value; return *this; }
+};
+
+template <typename Subclass, typename Key, typename Compare, typename Container, typename Index>
+class _binary_flat_tree_base : private detail::comparator_store<Compare>, private detail::index_store<typename Index::template store<Key, Compare>>, private detail::segment_store<Key, Container>
 {
 public:
     Container _container;
 
+private:
+    // Only read by cursors, which are nested classes.
+    detail::mutation_epoch _epoch;
+
 public:
     using key_type               = Key;
     using value_type             = typename Container::value_type;
@@ -57,32 +117,243 @@ public:
 
     using detail::comparator_store<Compare>::_comp;
 
+    using _index_store = typename Index::template store<Key, Compare>;
+    using detail::index_store<_index_store>::_index;
+    using _segment_store = detail::segment_store<Key, Container>;
+
+    // Merging the insertion buffer may throw from the comparator or the elements.
+    static constexpr bool _nothrow_view = !concepts::Buffering<_index_store>;
+
+    struct _key_view
+    {
+        iterator first;
+        size_type count;
+
+        size_type size() const noexcept { return count; }
+        decltype(auto) operator[](size_type n) const
+        {
+            if constexpr (detail::is_tied_sequence_v<Container>) { return *std::next(first.template base<0>(), n); }
+            else { return Subclass::_key_extractor(*std::next(first, n)); }
+        }
+    };
+
+    void _invalidate_index() noexcept
+    {
+        ++_epoch.value;
+        if constexpr (concepts::Invalidatable<_index_store>) { _index().invalidate(); }
+    }
+
+    // Called after the elements are rearranged.
+    void _invalidate() noexcept
+    {
+        _invalidate_index();
+        _rebuild_segment_keys();
+    }
+
+    void _invalidate_inserted(const_iterator itr) noexcept
+    {
+        ++_epoch.value;
+        if constexpr (concepts::Patchable<_index_store>) { _index().inserted(Subclass::_key_extractor(*itr), static_cast<size_type>(std::distance(_container.cbegin(), itr))); }
+        else if constexpr (concepts::Filtering<_index_store>) { _index().add(Subclass::_key_extractor(*itr)); }
+        else if constexpr (concepts::Invalidatable<_index_store>) { _index().invalidate(); }
+        _update_segment_keys(itr);
+    }
+
+    void _invalidate_buffered(size_type n) noexcept
+    {
+        ++_epoch.value;
+        _index().push(n);
+        _rebuild_segment_keys();
+    }
+
+    // An index of positions is patched, and a filter of keys is still valid as it might answer false positives anyway.
+    // Elements erased from the insertion buffer are uncounted.
+    void _invalidate_erased(const_iterator first, const_iterator last) noexcept
+    {
+        ++_epoch.value;
+        if constexpr (concepts::Buffering<_index_store>)
+        {
+            auto const sorted = size() - _index().pending();
+            auto const lo = std::max(static_cast<size_type>(std::distance(_container.cbegin(), first)), sorted);
+            auto const hi = std::max(static_cast<size_type>(std::distance(_container.cbegin(), last)), sorted);
+            _index().drop(hi - lo);
+        }
+        else if constexpr (concepts::Patchable<_index_store>)
+        {
+            _index().erased(static_cast<size_type>(std::distance(_container.cbegin(), first)), static_cast<size_type>(std::distance(first, last)));
+        }
+        else if constexpr (!concepts::Filtering<_index_store>)
+        {
+            _invalidate_index();
+        }
+    }
+
+    // Rebuilds the first keys of the segments, which are left out of sync on failure so that the search loads the segments instead.
+    void _rebuild_segment_keys() noexcept
+    {
+        if constexpr (_segment_store::_has_segment_keys)
+        {
+            this->_segment_keys_valid = false;
+            try
+            {
+                this->_segment_keys.clear();
+                for (size_type i = 0; i < _container.segment_count(); ++i) { this->_segment_keys.push_back(Subclass::_key_extractor(_container.segment_data(i)[0])); }
+                this->_segment_keys_valid = true;
+            }
+            catch (...) { }
+        }
+    }
+
+    // Patches the first keys of the segments after an element is inserted at `pos`, or elements are erased before `pos` without moving the others.
+    // A split or a merge changes only the segment at `pos` and its neighbours, otherwise the number of segments differs by more than one.
+    void _update_segment_keys([[maybe_unused]] const_iterator pos) noexcept
+    {
+        if constexpr (_segment_store::_has_segment_keys)
+        {
+            auto& keys = this->_segment_keys;
+            auto const count = _container.segment_count();
+            if (!this->_segment_keys_valid || count + 1 < keys.size() || keys.size() + 1 < count) { return _rebuild_segment_keys(); }
+
+            auto const [segment, offset] = _container.segment_position(pos);
+            auto const first_key = [this](size_type i) -> Key const& { return Subclass::_key_extractor(_container.segment_data(i)[0]); };
+            try
+            {
+                if (keys.size() == count)
+                {
+                    if (offset == 0 && segment != count) { keys[segment] = first_key(segment); }
+                }
+                else if (keys.size() < count)
+                {
+                    keys.insert(std::next(keys.begin(), static_cast<difference_type>(segment)), first_key(segment));
+                    if (segment + 1 != count) { keys[segment + 1] = first_key(segment + 1); }
+                }
+                else
+                {
+                    keys.erase(std::next(keys.begin(), static_cast<difference_type>(std::min(segment, count))));
+                    if (segment != 0) { keys[segment - 1] = first_key(segment - 1); }
+                    if (segment != count) { keys[segment] = first_key(segment); }
+                }
+            }
+            catch (...) { this->_segment_keys_valid = false; }
+        }
+    }
+
+    // Called before the container is modified otherwise, until the next rebuild.
+    void _drop_segment_keys() noexcept
+    {
+        if constexpr (_segment_store::_has_segment_keys) { this->_segment_keys_valid = false; }
+    }
+
+    // The first keys of the segments, or null unless they are in sync with the container.
+    Key const* _segment_keys_data() const noexcept
+    {
+        if constexpr (_segment_store::_has_segment_keys)
+        {
+            if (this->_segment_keys_valid && this->_segment_keys.size() == _container.segment_count()) { return this->_segment_keys.data(); }
+        }
+        return nullptr;
+    }
+
+    iterator _pending_begin() { return std::prev(_container.end(), static_cast<difference_type>(_pending_size())); }
+
+    size_type _pending_size() const noexcept
+    {
+        if constexpr (concepts::Buffering<_index_store>) { return _index().pending(); }
+        else { return 0; }
+    }
+
+    // Merges the insertion buffer into the sorted range, which is done even through const member functions as same as building an index.
+    void _merge_pending() const noexcept(_nothrow_view)
+    {
+        if (_pending_size() == 0) { return; }
+        auto self = const_cast<_binary_flat_tree_base*>(this);
+        std::inplace_merge(self->_container.begin(), self->_pending_begin(), self->_container.end(), self->_vcomp());
+        self->_invalidate();
+    }
+
+    // Merges the insertion buffer if `itr` points into it, and returns where the element is placed after that.
+    // inplace_merge is stable, so the element is placed after all equivalent ones in the sorted range.
+    iterator _merge_pending(iterator itr)
+    {
+        auto const first = _pending_begin();
+        if (std::distance(first, itr) < 0) { return itr; }
+        auto const pos = std::distance(first, itr) + std::distance(_container.begin(), _bound_in<true>(Subclass::_key_extractor(*itr), _container.begin(), first));
+        _merge_pending();
+        return std::next(_container.begin(), pos);
+    }
+
     auto _vcomp() const { return static_cast<typename Subclass::_comparator>(key_comp()); }
     auto _veq() const
     {
-        return [comp = _vcomp()](value_type const& lhs, value_type const& rhs)
+        if constexpr (detail::is_three_way_v<Compare>)
+        {
+            return [comp = key_comp()](value_type const& lhs, value_type const& rhs)
+            {
+                return comp(Subclass::_key_extractor(lhs), Subclass::_key_extractor(rhs)) == 0;
+            };
+        }
+        else
         {
-            return !comp(lhs, rhs) && !comp(rhs, lhs);
-        };
+            return [comp = _vcomp()](value_type const& lhs, value_type const& rhs)
+            {
+                return !comp(lhs, rhs) && !comp(rhs, lhs);
+            };
+        }
+    }
+
+    // Less-than comparator of keys.
+    decltype(auto) _kcomp() const
+    {
+        if constexpr (detail::is_three_way_v<Compare>) { return detail::three_way_less<Compare>{this->_comp()}; }
+        else { return this->_comp(); }
+    }
+
+    // Elements are moved back and forth during a radix sort, which can't be undone if a move throws.
+    static constexpr bool _radix_sortable_v = detail::is_radix_sortable_v<Key, Compare> && concepts::Contiguous<Container> && !detail::is_tied_sequence_v<Container> && std::is_nothrow_move_assignable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>;
+
+    // Stable sort of the elements by key, which is a radix sort for arithmetic keys ordered by std::less or std::greater.
+    // A range of sorted runs in ascending or descending order is merged instead, if they are at least 16 elements long on average.
+    // Radix sort takes linear time, so that it's preferred over merging more than 16 runs.
+    void _stable_sort(iterator first, iterator last)
+    {
+        auto const n = static_cast<size_type>(std::distance(first, last));
+        auto const max_runs = _radix_sortable_v && n >= 256 ? 16 : n / 16 + 1;
+        if (detail::merge_natural_runs(first, last, _vcomp(), max_runs)) { return; }
+
+        if constexpr (_radix_sortable_v)
+        {
+            if (n >= 256)
+            {
+                auto const data = _container.data();
+                std::vector<value_type, allocator_type> buffer(get_allocator());
+                detail::radix_sort(data + std::distance(_container.begin(), first), data + std::distance(_container.begin(), last), buffer, [](value_type const& value)
+                {
+                    return detail::radix_key<Key, Compare>(Subclass::_key_extractor(value));
+                });
+                return;
+            }
+        }
+        std::stable_sort(first, last, _vcomp());
     }
 
     template <typename InputIterator>
     void _initialize_container(InputIterator first, InputIterator last)
     {
         _container.assign(first, last);
-        std::stable_sort(_container.begin(), _container.end(), _vcomp());
+        _stable_sort(_container.begin(), _container.end());
         if constexpr (Subclass::_order == range_order::unique_sorted)
         {
             auto itr = std::unique(_container.begin(), _container.end(), _veq());
             _container.erase(itr, _container.end());
         }
+        _invalidate();
     }
 
     void _sort_container(range_order order)
     {
         if (order == range_order::no_ordered || order == range_order::uniqued)
         {
-            std::stable_sort(_container.begin(), _container.end(), _vcomp());
+            _stable_sort(_container.begin(), _container.end());
         }
         if constexpr (Subclass::_order == range_order::unique_sorted)
         {
@@ -92,6 +363,134 @@ public:
                 _container.erase(itr, _container.end());
             }
         }
+        _invalidate();
+    }
+
+    static constexpr bool _parallel_v = concepts::Contiguous<Container> && !detail::is_tied_sequence_v<Container> && std::is_default_constructible_v<value_type>;
+
+    // Sorts the elements after `mid` unless `order` is sorted, merges them into the sorted elements before `mid`, and removes duplicates for unique containers, on threads.
+    // Returns false without doing anything if it is not worth running in parallel.
+    bool _parallel_sort_container(parallel_policy policy, size_type mid, range_order order)
+    {
+        if constexpr (_parallel_v)
+        {
+            auto n = _container.size();
+            auto const threads = detail::thread_count(policy, n);
+            if (threads == 1) { return false; }
+
+            auto const data = _container.data();
+            std::vector<value_type, allocator_type> buffer(n, get_allocator());
+            auto const comp = _vcomp();
+            auto result = data + mid;
+            if (order == range_order::no_ordered || order == range_order::uniqued)
+            {
+                result = detail::parallel_stable_sort(data + mid, data + n, buffer.data() + mid, threads, [&](value_type* first, value_type* last)
+                {
+                    _stable_sort(std::next(_container.begin(), first - data), std::next(_container.begin(), last - data));
+                }, comp);
+            }
+            if (mid != 0)
+            {
+                if (result != data + mid) { detail::parallel_move(result, buffer.data() + n, data + mid, threads); }
+                result = data;
+                if (mid != n)
+                {
+                    detail::parallel_merge_runs(data, {0, mid, n}, buffer.data(), threads, comp);
+                    result = buffer.data();
+                }
+            }
+            else if (result != data)
+            {
+                result = buffer.data();
+            }
+
+            if constexpr (Subclass::_order == range_order::unique_sorted)
+            {
+                if (mid != 0 || order == range_order::no_ordered || order == range_order::sorted)
+                {
+                    auto const other = result == data ? buffer.data() : data;
+                    n = detail::parallel_unique_move(result, result + n, other, threads, _veq());
+                    result = other;
+                }
+            }
+            if (result != data) { detail::parallel_move(result, result + n, data, threads); }
+            _container.erase(std::next(_container.begin(), static_cast<difference_type>(n)), _container.end());
+            _invalidate();
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <typename InputIterator>
+    void _initialize_container(parallel_policy policy, InputIterator first, InputIterator last)
+    {
+        _container.assign(first, last);
+        _sort_container(policy, range_order::no_ordered);
+    }
+
+    void _sort_container(parallel_policy policy, range_order order)
+    {
+        if (!_parallel_sort_container(policy, 0, order)) { _sort_container(order); }
+    }
+
+    // Erases the elements in sorted [mid, end()) which are equivalent to the previous one or to any in sorted [first, last).
+    void _erase_found(iterator first, iterator last, iterator mid)
+    {
+        auto write = mid;
+        auto const end = _container.end();
+        for (auto read = mid; read != end; ++read)
+        {
+            auto const& key = Subclass::_key_extractor(*read);
+            if (write != mid && !detail::invoke_less(_comp(), Subclass::_key_extractor(*std::prev(write)), key)) { continue; }
+            first = _bound_near<false, false>(key, first, last);
+            if (first != last && !detail::invoke_less(_comp(), key, Subclass::_key_extractor(*first))) { continue; }
+            if (write != read) { *write = std::move(*read); }
+            ++write;
+        }
+        _container.erase(write, end);
+    }
+
+    // Merges the elements inserted at `mid` into the sorted elements before it, where the inserted ones are sorted by themselves unless `order` is sorted.
+    // Unique container drops the inserted elements equivalent to a preceding one or to an existing one in advance, by exponential search from the previous one.
+    void _merge_inserted(iterator mid, range_order order)
+    {
+        auto const size = std::distance(_container.begin(), mid);
+        if (order == range_order::no_ordered || order == range_order::uniqued) { _stable_sort(mid, _container.end()); }
+        if constexpr (Subclass::_order == range_order::unique_sorted)
+        {
+            _erase_found(_container.begin(), mid, mid);
+            mid = std::next(_container.begin(), size);
+        }
+
+        // Only the elements between the seams are out of place.
+        if (mid != _container.begin() && mid != _container.end())
+        {
+            auto const first = std::upper_bound(_container.begin(), mid, *mid, _vcomp());
+            auto const last = std::lower_bound(mid, _container.end(), *std::prev(mid), _vcomp());
+            std::inplace_merge(first, mid, last, _vcomp());
+        }
+        _invalidate();
+    }
+
+    // Same as _merge_inserted, except that the elements are merged into the insertion buffer, which is merged when it gets full.
+    void _buffer_inserted(iterator mid, range_order order)
+    {
+        auto const size = std::distance(_container.begin(), mid);
+        auto const sorted = size - static_cast<difference_type>(_pending_size());
+        if (order == range_order::no_ordered || order == range_order::uniqued) { _stable_sort(mid, _container.end()); }
+        if constexpr (Subclass::_order == range_order::unique_sorted)
+        {
+            _erase_found(_container.begin(), std::next(_container.begin(), sorted), std::next(_container.begin(), size));
+            _erase_found(std::next(_container.begin(), sorted), std::next(_container.begin(), size), std::next(_container.begin(), size));
+            mid = std::next(_container.begin(), size);
+        }
+
+        std::inplace_merge(std::next(_container.begin(), sorted), mid, _container.end(), _vcomp());
+        _invalidate_buffered(static_cast<size_type>(std::distance(mid, _container.end())));
+        if (_index().full(_container.size())) { _merge_pending(); }
     }
 
 public:
@@ -105,11 +504,14 @@ public:
 
     _binary_flat_tree_base(_binary_flat_tree_base const& other) = default;
     _binary_flat_tree_base(_binary_flat_tree_base const& other, allocator_type const& alloc)
-      : detail::comparator_store<Compare>{other._comp()}, _container{other._container, alloc} { }
+      : detail::comparator_store<Compare>{other._comp()}, detail::index_store<_index_store>(other), _segment_store(other), _container{other._container, alloc} { }
 
     _binary_flat_tree_base(_binary_flat_tree_base&& other) = default;
     _binary_flat_tree_base(_binary_flat_tree_base&& other, allocator_type const& alloc)
-      : detail::comparator_store<Compare>{std::move(other._comp())}, _container{std::move(other._container), alloc} { }
+      : detail::comparator_store<Compare>{std::move(other._comp())}, detail::index_store<_index_store>(std::move(other)), _segment_store(std::move(other)), _container{std::move(other._container), alloc}
+    {
+        other._invalidate();
+    }
 
     explicit _binary_flat_tree_base(range_order order, Container cont)
       : _container{std::move(cont)}
@@ -123,28 +525,46 @@ public:
         _sort_container(order);
     }
 
+    explicit _binary_flat_tree_base(parallel_policy policy, range_order order, Container cont, Compare const& comp)
+      : detail::comparator_store<Compare>{comp}, _container{std::move(cont)}
+    {
+        _sort_container(policy, order);
+    }
+
     _binary_flat_tree_base& operator=(_binary_flat_tree_base const& other) = default;
 
     _binary_flat_tree_base& operator=(_binary_flat_tree_base&& other) noexcept(noexcept(_container = std::move(other._container)) && std::is_nothrow_move_assignable_v<Compare>) = default;
 
     allocator_type get_allocator() const noexcept { return _container.get_allocator(); }
 
-    auto& base() & noexcept { return _container; }
-    auto base() && noexcept { return std::move(_container); }
-    auto const& base() const& noexcept { return _container; }
-
-    iterator begin() noexcept { return _container.begin(); }
-    const_iterator begin() const noexcept { return _container.begin(); }
-    const_iterator cbegin() const noexcept { return _container.cbegin(); }
-    iterator end() noexcept { return _container.end(); }
-    const_iterator end() const noexcept { return _container.end(); }
-    const_iterator cend() const noexcept { return _container.cend(); }
-    reverse_iterator rbegin() noexcept { return _container.rbegin(); }
-    const_reverse_iterator rbegin() const noexcept { return _container.rbegin(); }
-    const_reverse_iterator crbegin() const noexcept { return _container.crbegin(); }
-    reverse_iterator rend() noexcept { return _container.rend(); }
-    const_reverse_iterator rend() const noexcept { return _container.rend(); }
-    const_reverse_iterator crend() const noexcept { return _container.crend(); }
+    // The container might be modified through the reference, so that the first keys of the segments are rebuilt by the next modification.
+    auto& base() & noexcept(_nothrow_view)
+    {
+        _merge_pending();
+        _invalidate_index();
+        _drop_segment_keys();
+        return _container;
+    }
+    auto base() && noexcept(_nothrow_view)
+    {
+        _merge_pending();
+        _invalidate();
+        return std::move(_container);
+    }
+    auto const& base() const& noexcept(_nothrow_view) { _merge_pending(); return _container; }
+
+    iterator begin() noexcept(_nothrow_view) { _merge_pending(); return _container.begin(); }
+    const_iterator begin() const noexcept(_nothrow_view) { _merge_pending(); return _container.begin(); }
+    const_iterator cbegin() const noexcept(_nothrow_view) { _merge_pending(); return _container.cbegin(); }
+    iterator end() noexcept(_nothrow_view) { _merge_pending(); return _container.end(); }
+    const_iterator end() const noexcept(_nothrow_view) { _merge_pending(); return _container.end(); }
+    const_iterator cend() const noexcept(_nothrow_view) { _merge_pending(); return _container.cend(); }
+    reverse_iterator rbegin() noexcept(_nothrow_view) { _merge_pending(); return _container.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept(_nothrow_view) { _merge_pending(); return _container.rbegin(); }
+    const_reverse_iterator crbegin() const noexcept(_nothrow_view) { _merge_pending(); return _container.crbegin(); }
+    reverse_iterator rend() noexcept(_nothrow_view) { _merge_pending(); return _container.rend(); }
+    const_reverse_iterator rend() const noexcept(_nothrow_view) { _merge_pending(); return _container.rend(); }
+    const_reverse_iterator crend() const noexcept(_nothrow_view) { _merge_pending(); return _container.crend(); }
 
     [[nodiscard]] bool empty() const noexcept { return _container.empty(); }
     size_type size() const noexcept { return _container.size(); }
@@ -155,18 +575,197 @@ public:
     size_type capacity() const noexcept { return _container.capacity(); }
     // extension
     void shrink_to_fit() { _container.shrink_to_fit(); }
-    void clear() noexcept { return _container.clear(); }
+    // extension
+    void freeze()
+    {
+        _merge_pending();
+        if constexpr (concepts::Invalidatable<_index_store>) { _index().build(_key_view{_container.begin(), size()}); }
+        if (!_segment_keys_data()) { _rebuild_segment_keys(); }
+    }
+    void clear() noexcept
+    {
+        _container.clear();
+        _invalidate();
+    }
+
+    template <bool Upper, typename K>
+    std::pair<iterator, iterator> _search_range(K const& key)
+    {
+        if constexpr (concepts::Invalidatable<_index_store>)
+        {
+            auto [lo, hi] = _index().narrow(_key_view{_container.begin(), size()}, detail::bound_predicate<K, Compare, Upper>{key, _comp()});
+            return {std::next(_container.begin(), lo), std::next(_container.begin(), hi)};
+        }
+        else
+        {
+            return {_container.begin(), _container.end()};
+        }
+    }
+
+    template <typename K>
+    static constexpr bool _branchless_v = std::is_same_v<K, Key> && concepts::Contiguous<Container> && detail::is_branchless_comparable_v<Key, Compare>;
+
+    template <bool Upper, typename K>
+    iterator _bound(K const& key)
+    {
+        auto [first, last] = _search_range<Upper>(key);
+        auto itr = _bound_in<Upper>(key, first, last);
+        if constexpr (concepts::Memoizable<_index_store>) { _index().memoize(static_cast<size_type>(std::distance(_container.begin(), itr))); }
+        return itr;
+    }
+
+    template <bool Upper, typename K>
+    iterator _bound_in(K const& key, iterator first, iterator last)
+    {
+        if constexpr (_branchless_v<K>)
+        {
+            auto const [keys, proj] = detail::key_column(_container, [](auto const& value) -> auto& { return Subclass::_key_extractor(value); });
+            auto const lo = static_cast<size_type>(std::distance(_container.begin(), first));
+            auto const n = static_cast<size_type>(std::distance(first, last));
+            if constexpr (detail::is_simd_searchable_v<Key, Compare> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<decltype(keys)>>, Key>)
+            {
+                return std::next(_container.begin(), lo + detail::simd_partition_point<Upper>(keys + lo, n, key, _comp()));
+            }
+            else
+            {
+                return std::next(_container.begin(), lo + detail::branchless_partition_point(keys + lo, n, proj, detail::bound_predicate<K, Compare, Upper>{key, _comp()}));
+            }
+        }
+        else if constexpr (detail::is_tied_sequence_v<Container>)
+        {
+            // Searches the key column alone, not to load the other columns for every comparison.
+            auto const keys = first.template base<0>();
+            if constexpr (Upper) { return std::next(first, std::distance(keys, std::upper_bound(keys, last.template base<0>(), key, _kcomp()))); }
+            else { return std::next(first, std::distance(keys, std::lower_bound(keys, last.template base<0>(), key, _kcomp()))); }
+        }
+        else if constexpr (concepts::Segmented<Container>)
+        {
+            // Finds the segment by its first key, then searches within the contiguous segment.
+            // The first keys are searched contiguously while in sync, otherwise loaded from every segment.
+            if (first == last) { return first; }
+            auto const [lo, lo_offset] = _container.segment_position(first);
+            auto const [hi, hi_offset] = _container.segment_position(last);
+            auto const pred = detail::bound_predicate<K, Compare, Upper>{key, _comp()};
+            auto const keys = _segment_keys_data();
+            auto segment = lo;
+            for (auto n = hi + (hi_offset != 0) - (lo + 1); n > 0;)
+            {
+                auto const half = n / 2;
+                auto const next = segment + 1 + half;
+                if (pred(keys ? keys[next] : Subclass::_key_extractor(_container.segment_data(next)[0])))
+                {
+                    segment += half + 1;
+                    n -= half + 1;
+                }
+                else { n = half; }
+            }
+            auto const data = _container.segment_data(segment);
+            auto const itr = std::partition_point(data + (segment == lo ? lo_offset : 0), data + (segment == hi ? hi_offset : _container.segment_size(segment)), [&](auto const& value)
+            {
+                return pred(Subclass::_key_extractor(value));
+            });
+            return _container.segment_iterator(segment, static_cast<size_type>(itr - data));
+        }
+        else if constexpr (Upper)
+        {
+            return std::upper_bound(first, last, key, _vcomp());
+        }
+        else
+        {
+            return std::lower_bound(first, last, key, _vcomp());
+        }
+    }
+
+    template <typename K>
+    iterator _lower_bound(K const& key)
+    {
+        _merge_pending();
+        return _bound<false>(key);
+    }
+
+    template <typename K>
+    iterator _upper_bound(K const& key)
+    {
+        _merge_pending();
+        return _bound<true>(key);
+    }
 
+    // Lower bound search with three-way comparator, which also tells whether the key is found, by one comparison per step.
+    // Unique container returns as soon as the key is found.
+    template <typename K>
+    std::pair<iterator, bool> _three_way_search(K const& key, const_iterator first, const_iterator last)
+    {
+        auto lo = static_cast<size_type>(std::distance(_container.cbegin(), first));
+        auto n = static_cast<size_type>(std::distance(first, last));
+        bool found = false;
+        while (n > 0)
+        {
+            auto const half = n / 2;
+            auto const c = this->_comp()(key, _key_at(lo + half));
+            if (c > 0)
+            {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                found = c == 0;
+                if constexpr (Subclass::_order == range_order::unique_sorted) { if (found) { return {std::next(_container.begin(), lo + half), true}; } }
+                n = half;
+            }
+        }
+        return {std::next(_container.begin(), lo), found};
+    }
+
+    // The insertion buffer is merged in advance, as the position is either returned or inserted at.
     template <typename K>
     std::pair<iterator, bool> _find(K const& key)
     {
-        auto itr = lower_bound(key);
-        return {itr, !(itr == end() || _vcomp()(key, *itr))};
+        _merge_pending();
+        if constexpr (detail::is_three_way_v<Compare>)
+        {
+            auto [first, last] = _search_range<false>(key);
+            auto [itr, found] = _three_way_search(key, first, last);
+            // the index may narrow the range just before the key
+            if (itr == last && last != _container.end()) { found = this->_comp()(key, Subclass::_key_extractor(*last)) == 0; }
+            if constexpr (concepts::Memoizable<_index_store>) { _index().memoize(static_cast<size_type>(std::distance(_container.begin(), itr))); }
+            return {itr, found};
+        }
+        else
+        {
+            auto itr = _lower_bound(key);
+            return {itr, !(itr == _container.end() || _vcomp()(key, *itr))};
+        }
     }
 
     template <typename K>
     std::pair<const_iterator, bool> _find(K const& key) const { return const_cast<_binary_flat_tree_base*>(this)->_find(key); }
 
+    template <typename K>
+    bool _may_contain(K const& key)
+    {
+        if constexpr (concepts::Filtering<_index_store>) { return _index().may_contain(_key_view{_container.begin(), size()}, key); }
+        else { return true; }
+    }
+
+    // Same as _find, except that keys rejected by the filter aren't searched and end() is returned.
+    // The insertion buffer isn't merged but searched unless found in the sorted range, so the position found in it is merged by the caller if needed.
+    template <typename K>
+    std::pair<iterator, bool> _find_existing(K const& key)
+    {
+        if (!_may_contain(key)) { return {_container.end(), false}; }
+        if constexpr (concepts::Buffering<_index_store>)
+        {
+            auto const first = _pending_begin();
+            if (auto result = _find_in(key, _container.begin(), first); result.second) { return result; }
+            return _find_in(key, first, _container.end());
+        }
+        else { return _find(key); }
+    }
+
+    template <typename K>
+    std::pair<const_iterator, bool> _find_existing(K const& key) const { return const_cast<_binary_flat_tree_base*>(this)->_find_existing(key); }
+
     template <typename V>
     auto _insert(V&& value)
     {
@@ -174,13 +773,12 @@ public:
         {
             // It should be guaranteed that the value isn't changed when found
             auto [itr, found] = _find(Subclass::_key_extractor(value));
-            if (!found) { itr = _container.insert(itr, std::forward<V>(value)); }
+            if (!found) { itr = _emplace_at(itr, std::forward<V>(value)); }
             return std::make_pair(itr, !found);
         }
         else
         {
-            auto itr = upper_bound(Subclass::_key_extractor(value));
-            return _container.insert(itr, std::forward<V>(value));
+            return _emplace_at(_upper_bound(Subclass::_key_extractor(value)), std::forward<V>(value));
         }
     }
 
@@ -201,16 +799,46 @@ private:
     }
 
 public:
+    template <typename... Args>
+    iterator _emplace_at(const_iterator pos, Args&&... args)
+    {
+        auto itr = _container.emplace(pos, std::forward<Args>(args)...);
+        _invalidate_inserted(itr);
+        return itr;
+    }
+
+public:
+    // A valid hint is taken after the insertion buffer is merged, since every member function which returns a position merges it.
     auto _insert_point_uniq(const_iterator hint, key_type const& key)
     {
-        if (hint != end())
+        if constexpr (detail::is_three_way_v<Compare>)
+        {
+            if (hint == _container.end())
+            {
+                bool insert_here = hint == _container.begin() || this->_comp()(key, Subclass::_key_extractor(*std::prev(hint))) > 0;
+                if (!insert_here) { return _find(key); }
+                return std::make_pair(_mutable(hint), false);
+            }
+
+            auto const c = this->_comp()(key, Subclass::_key_extractor(*hint));
+            if (c == 0) { return std::make_pair(_mutable(hint), true); }
+            if (c > 0) { return _three_way_search_near<false>(key, std::next(hint), _container.cend()); }
+            if (hint == _container.begin()) { return std::make_pair(_mutable(hint), false); }
+
+            auto const prev = std::prev(hint);
+            auto const p = this->_comp()(key, Subclass::_key_extractor(*prev));
+            if (p > 0) { return std::make_pair(_mutable(hint), false); }
+            if (p == 0) { return std::make_pair(_mutable(prev), true); }
+            return _three_way_search_near<true>(key, _container.cbegin(), prev);
+        }
+        else if (hint != _container.end())
         {
             if (_vcomp()(key, *hint))
             {
-                bool insert_here = hint == begin() || _vcomp()(*std::prev(hint), key); // 1
+                bool insert_here = hint == _container.begin() || _vcomp()(*std::prev(hint), key); // 1
                 if (!insert_here)
                 {
-                    hint = std::lower_bound(cbegin(), std::prev(hint), key, _vcomp());
+                    hint = _bound_near<false, true>(key, _container.cbegin(), std::prev(hint));
                     bool found_insert_point = _vcomp()(key, *hint); // 2
                     if (!found_insert_point) { return std::make_pair(_mutable(hint), true); } // 3
                 }
@@ -220,32 +848,32 @@ public:
                 bool found_value = !_vcomp()(*hint, key);
                 if (found_value) { return std::make_pair(_mutable(hint), true); } // 4
 
-                hint = std::lower_bound(std::next(hint), cend(), key, _vcomp());
-                bool found_insert_point = hint == end() || _vcomp()(key, *hint); // 5
+                hint = _bound_near<false, false>(key, std::next(hint), _container.cend());
+                bool found_insert_point = hint == _container.end() || _vcomp()(key, *hint); // 5
                 if (!found_insert_point) { return std::make_pair(_mutable(hint), true); } // 6
             }
         }
         else
         {
-            bool insert_here = hint == begin() || _vcomp()(*std::prev(hint), key); // 7
+            bool insert_here = hint == _container.begin() || _vcomp()(*std::prev(hint), key); // 7
             if (!insert_here) { return _find(key); } // 8
         }
         return std::make_pair(_mutable(hint), false);
     }
 
-    auto _insert_point_multi(const_iterator hint, key_type const& key)
+    const_iterator _insert_point_multi(const_iterator hint, key_type const& key)
     {
-        if (hint == end() || !_vcomp()(*hint, key))
+        if (hint == _container.end() || !_vcomp()(*hint, key))
         {
-            bool insert_here = hint == begin() || !_vcomp()(key, *std::prev(hint)); // 1
+            bool insert_here = hint == _container.begin() || !_vcomp()(key, *std::prev(hint)); // 1
             if (!insert_here)
             {
-                hint = std::upper_bound(cbegin(), std::prev(hint), key, _vcomp()); // 2
+                hint = _bound_near<true, true>(key, _container.cbegin(), std::prev(hint)); // 2
             }
         }
         else
         {
-            hint = std::lower_bound(std::next(hint), cend(), key, _vcomp()); // 3
+            hint = _bound_near<false, false>(key, std::next(hint), _container.cend()); // 3
         }
         return hint;
     }
@@ -256,13 +884,13 @@ public:
         if constexpr (Subclass::_order == range_order::unique_sorted)
         {
             auto [itr, found] = _insert_point_uniq(hint, Subclass::_key_extractor(value));
-            if (!found) { itr = _container.insert(itr, std::forward<V>(value)); }
+            if (!found) { itr = _emplace_at(itr, std::forward<V>(value)); }
             return itr;
         }
         else
         {
             auto itr = _insert_point_multi(hint, Subclass::_key_extractor(value));
-            return _container.insert(itr, std::forward<V>(value));
+            return _emplace_at(itr, std::forward<V>(value));
         }
     }
 
@@ -283,24 +911,22 @@ public:
     template <typename InputIterator>
     void insert(range_order order, InputIterator first, InputIterator last)
     {
+        // The container might lay out the segments again, which are searched until merged.
+        _drop_segment_keys();
         auto mid = _container.insert(_container.end(), first, last);
-        switch (order)
-        {
-        case range_order::no_ordered:
-        case range_order::uniqued:
-            std::stable_sort(_container.begin(), _container.end(), _vcomp());
-            break;
+        if constexpr (concepts::Buffering<_index_store>) { _buffer_inserted(mid, order); }
+        else { _merge_inserted(mid, order); }
+    }
 
-        case range_order::sorted:
-        case range_order::unique_sorted:
-            std::inplace_merge(_container.begin(), mid, _container.end(), _vcomp());
-            break;
-        }
-        if constexpr (Subclass::_order == range_order::unique_sorted)
-        {
-            auto itr = std::unique(_container.begin(), _container.end(), _veq());
-            _container.erase(itr, _container.end());
-        }
+    // extension
+    template <typename InputIterator>
+    void insert(parallel_policy policy, range_order order, InputIterator first, InputIterator last)
+    {
+        _merge_pending();
+        _drop_segment_keys();
+        auto const size = _container.size();
+        auto mid = _container.insert(_container.end(), first, last);
+        if (!_parallel_sort_container(policy, size, order)) { _merge_inserted(mid, order); }
     }
 
     // extension
@@ -310,7 +936,7 @@ public:
     {
         if constexpr (Subclass::_order == range_order::unique_sorted)
         {
-            if (!node.value.has_value()) { return insert_return_type{end(), false, {}}; }
+            if (!node.value.has_value()) { return insert_return_type{_container.end(), false, {}}; }
             if (auto [itr, inserted] = _insert(std::move(*node.value)); inserted)
             {
                 return insert_return_type{itr, true, {}};
@@ -322,14 +948,14 @@ public:
         }
         else
         {
-            if (!node.value.has_value()) { return end(); }
+            if (!node.value.has_value()) { return _container.end(); }
             return insert(std::move(*node.value));
         }
     }
 
     iterator insert(const_iterator hint, node_type&& node)
     {
-        if (!node.value.has_value()) { return end(); }
+        if (!node.value.has_value()) { return _container.end(); }
         return _insert(hint, std::move(*node.value));
     }
 
@@ -339,15 +965,76 @@ public:
     template <typename... Args>
     iterator emplace_hint(const_iterator hint, Args&&... args) { return _insert(hint, value_type(std::forward<Args>(args)...)); }
 
-    iterator erase(iterator pos) { return _container.erase(pos); }
-    iterator erase(const_iterator pos) { return _container.erase(pos); }
-    iterator erase(const_iterator first, const_iterator last) { return _container.erase(first, last); }
+    iterator erase(iterator pos) { return erase(const_iterator{pos}); }
+
+    iterator erase(const_iterator pos)
+    {
+        _invalidate_erased(pos, std::next(pos));
+        auto itr = _container.erase(pos);
+        _update_segment_keys(itr);
+        return itr;
+    }
+
+    // The elements might be moved before range erasure, such as by erase_if or std::remove_if, so that an index of positions and the first keys of the segments aren't patched but rebuilt.
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        if constexpr (concepts::Patchable<_index_store>) { _invalidate_index(); }
+        else { _invalidate_erased(first, last); }
+        auto itr = _container.erase(first, last);
+        _rebuild_segment_keys();
+        return itr;
+    }
 
     size_type erase(key_type const& key)
     {
         auto [first, last] = _equal_range(key);
         auto count = std::distance(first, last);
-        _container.erase(first, last);
+        _invalidate_erased(first, last);
+        _update_segment_keys(_container.erase(first, last));
+        return count;
+    }
+
+    // extension
+    template <typename InputIterator>
+    size_type erase_keys(InputIterator first, InputIterator last) { return erase_keys(range_order::no_ordered, first, last); }
+
+    // extension
+    template <typename InputIterator>
+    size_type erase_keys(range_order order, InputIterator first, InputIterator last)
+    {
+        using K = _lookup_key_t<InputIterator>;
+        if (order == range_order::no_ordered || order == range_order::uniqued)
+        {
+            std::vector<K> keys(first, last);
+            std::sort(keys.begin(), keys.end(), [this](K const& lhs, K const& rhs) { return detail::invoke_less(_comp(), lhs, rhs); });
+            return erase_keys(range_order::sorted, keys.begin(), keys.end());
+        }
+
+        _merge_pending();
+        // Elements in [read, end) are intact, and kept ones are shifted down to `write` segment by segment.
+        auto read = _container.begin();
+        auto write = read;
+        auto const end = _container.end();
+        for (; first != last && read != end; ++first)
+        {
+            K const& key = *first;
+            auto lo = _bound_near<false, false>(key, read, end);
+            if (lo == end || detail::invoke_less(_comp(), key, Subclass::_key_extractor(*lo)))
+            {
+                continue;
+            }
+
+            auto hi = std::next(lo);
+            if constexpr (Subclass::_order != range_order::unique_sorted) { hi = _bound_near<true, false>(key, hi, end); }
+            write = write == read ? lo : std::move(read, lo, write);
+            read = hi;
+        }
+        if (write == read) { return 0; }
+
+        write = std::move(read, end, write);
+        auto const count = static_cast<size_type>(std::distance(write, end));
+        _container.erase(write, end);
+        _invalidate();
         return count;
     }
 
@@ -355,16 +1042,20 @@ public:
     {
         using std::swap;
         swap(this->_comp(), other._comp());
+        swap(this->_index(), other._index());
+        swap(static_cast<_segment_store&>(*this), static_cast<_segment_store&>(other));
         swap(_container, other._container);
+        ++_epoch.value;
+        ++other._epoch.value;
     }
 
     node_type extract(const_iterator position)
     {
         // standard requires `valid dereferenceable constant iterator`
-        assert(position != cend());
+        assert(position != _container.cend());
 
         node_type node{std::move(*_mutable(position))};
-        _container.erase(position);
+        erase(position);
         return node;
     }
 
@@ -383,6 +1074,17 @@ public:
     template <typename Cont>
     static constexpr bool _same_order_v = std::is_empty_v<key_compare> && std::is_same_v<typename Cont::key_compare, key_compare>;
 
+    template <typename K>
+    std::pair<iterator, bool> _find_in(K const& key, iterator first, iterator last)
+    {
+        if constexpr (detail::is_three_way_v<Compare>) { return _three_way_search(key, first, last); }
+        else
+        {
+            auto lb = _bound_in<false>(key, first, last);
+            return {lb, !(lb == last || _vcomp()(key, *lb))};
+        }
+    }
+
     template <typename Cont, typename Cond>
     iterator _move_distinct_elements(Cont& source, Cond multimap)
     {
@@ -394,15 +1096,15 @@ public:
         {
             auto const& key = Subclass::_key_extractor(*itr);
             auto const mid = std::next(_container.begin(), len);
-            auto lb = std::lower_bound(first, mid, key, _vcomp());
+            auto [lb, found] = _find_in(key, first, mid);
             [[maybe_unused]] auto const dist = std::distance(_container.begin(), lb);
-            if (lb == mid || _vcomp()(key, *lb))
+            if (!found)
             {
                 typename std::iterator_traits<typename Cont::iterator>::value_type tmp = std::move(*itr);
                 itr = source.erase(itr);
                 if constexpr (multimap)
                 {
-                    while (itr != source.end() && !comp(tmp, *itr)) { ++itr; }
+                    while (itr != source.end() && !detail::invoke_less(comp, tmp, *itr)) { ++itr; }
                 }
                 _container.emplace(_container.end(), std::move(tmp));
             }
@@ -419,6 +1121,8 @@ public:
     template <typename Cont, typename Cond>
     void _merge(Cont& source, [[maybe_unused]] Cond multimap)
     {
+        _merge_pending();
+        _drop_segment_keys();
         if constexpr (concepts::Reservable<Container>)
         {
             auto const require = size() + source.size();
@@ -440,11 +1144,12 @@ public:
             mid = _container.insert(_container.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
             if constexpr (!_same_order_v<Cont>)
             {
-                std::stable_sort(mid, _container.end(), _vcomp());
+                _stable_sort(mid, _container.end());
             }
         }
 
         std::inplace_merge(_container.begin(), mid, _container.end(), _vcomp());
+        _invalidate();
 
         if constexpr (Subclass::_order != range_order::unique_sorted)
         {
@@ -460,8 +1165,13 @@ public:
     template <typename K>
     size_type _count(K const& key) const
     {
-        auto [first, last] = equal_range(key);
-        return std::distance(first, last);
+        if (!const_cast<_binary_flat_tree_base*>(this)->_may_contain(key)) { return 0; }
+        if constexpr (Subclass::_order == range_order::unique_sorted) { return _find_existing(key).second ? 1 : 0; }
+        else
+        {
+            auto [first, last] = equal_range(key);
+            return std::distance(first, last);
+        }
     }
 
     size_type count(key_type const& key) const { return _count(key); }
@@ -471,8 +1181,10 @@ public:
 
     iterator find(key_type const& key)
     {
-        auto [itr, found] = _find(key);
-        return found ? itr : end();
+        auto [itr, found] = _find_existing(key);
+        if (!found) { return _container.end(); }
+        if constexpr (concepts::Buffering<_index_store>) { return _merge_pending(itr); }
+        else { return itr; }
     }
 
     const_iterator find(key_type const& key) const { return const_cast<_binary_flat_tree_base*>(this)->find(key); }
@@ -480,22 +1192,25 @@ public:
     template <typename K>
     enable_if_transparent<K, iterator> find(K const& key)
     {
-        auto [itr, found] = _find(key);
-        return found ? itr : end();
+        auto [itr, found] = _find_existing(key);
+        if (!found) { return _container.end(); }
+        if constexpr (concepts::Buffering<_index_store>) { return _merge_pending(itr); }
+        else { return itr; }
     }
 
     template <typename K>
     enable_if_transparent<K, const_iterator>
     find(K const& key) const { return const_cast<_binary_flat_tree_base*>(this)->template find<K>(key); }
 
-    bool contains(key_type const& key) const { return _find(key).second; }
+    bool contains(key_type const& key) const { return _find_existing(key).second; }
 
     template <typename K>
-    enable_if_transparent<K, bool> contains(K const& key) const { return _find(key).second; }
+    enable_if_transparent<K, bool> contains(K const& key) const { return _find_existing(key).second; }
 
     template <typename K>
     std::pair<iterator, iterator> _equal_range(K const& key)
     {
+        _merge_pending();
         if constexpr (Subclass::_order == range_order::unique_sorted)
         {
             auto [itr, found] = _find(key);
@@ -503,7 +1218,7 @@ public:
         }
         else
         {
-            return std::equal_range(begin(), end(), key, _vcomp());
+            return {_lower_bound(key), _upper_bound(key)};
         }
     }
 
@@ -518,30 +1233,329 @@ public:
     enable_if_transparent<K, std::pair<const_iterator, const_iterator>>
     equal_range(K const& key) const { return const_cast<_binary_flat_tree_base*>(this)->template equal_range<K>(key); }
 
-    iterator lower_bound(key_type const& key) { return std::lower_bound(begin(), end(), key, _vcomp()); }
+    iterator lower_bound(key_type const& key) { return _lower_bound(key); }
 
     const_iterator lower_bound(key_type const& key) const { return const_cast<_binary_flat_tree_base*>(this)->lower_bound(key); }
 
     template <typename K>
-    enable_if_transparent<K, iterator> lower_bound(K const& key) { return std::lower_bound(begin(), end(), key, _vcomp()); }
+    enable_if_transparent<K, iterator> lower_bound(K const& key) { return _lower_bound(key); }
 
     template <typename K>
     enable_if_transparent<K, const_iterator>
     lower_bound(K const& key) const { return const_cast<_binary_flat_tree_base*>(this)->template lower_bound<K>(key); }
 
-    iterator upper_bound(key_type const& key) { return std::upper_bound(begin(), end(), key, _vcomp()); }
+    iterator upper_bound(key_type const& key) { return _upper_bound(key); }
 
     const_iterator upper_bound(key_type const& key) const { return const_cast<_binary_flat_tree_base*>(this)->upper_bound(key); }
 
     template <typename K>
-    enable_if_transparent<K, iterator> upper_bound(K const& key) { return std::upper_bound(begin(), end(), key, _vcomp()); }
+    enable_if_transparent<K, iterator> upper_bound(K const& key) { return _upper_bound(key); }
 
     template <typename K>
     enable_if_transparent<K, const_iterator>
     upper_bound(K const& key) const { return const_cast<_binary_flat_tree_base*>(this)->template upper_bound<K>(key); }
 
+    decltype(auto) _key_at(size_type pos)
+    {
+        if constexpr (concepts::Contiguous<Container>)
+        {
+            auto const [keys, proj] = detail::key_column(_container, [](auto const& value) -> auto& { return Subclass::_key_extractor(value); });
+            return proj(keys[pos]);
+        }
+        else if constexpr (detail::is_tied_sequence_v<Container>)
+        {
+            return *std::next(_container.begin().template base<0>(), pos);
+        }
+        else
+        {
+            return Subclass::_key_extractor(*std::next(_container.begin(), pos));
+        }
+    }
+
+    void _prefetch_at(size_type pos)
+    {
+        if constexpr (concepts::Contiguous<Container> || detail::is_tied_sequence_v<Container>)
+        {
+            detail::prefetch(std::addressof(_key_at(pos)));
+        }
+        else if constexpr (std::is_lvalue_reference_v<reference>)
+        {
+            detail::prefetch(std::addressof(*std::next(_container.begin(), pos)));
+        }
+    }
+
+    // Narrows [first, last) to the range of the bound by exponential search, from `last` backward if Backward, otherwise from `first`.
+    // It takes O(log d) comparisons for the distance d between the origin and the bound.
+    template <bool Upper, bool Backward, typename K>
+    std::pair<size_type, size_type> _gallop(K const& key, const_iterator first, const_iterator last)
+    {
+        detail::bound_predicate<K, Compare, Upper> pred{key, _comp()};
+        auto lo = static_cast<size_type>(std::distance(_container.cbegin(), first));
+        auto hi = static_cast<size_type>(std::distance(_container.cbegin(), last));
+        for (size_type step = 1; hi - lo > step; step *= 2)
+        {
+            if constexpr (Backward)
+            {
+                auto const pos = hi - step;
+                if (pred(_key_at(pos))) { lo = pos + 1; break; }
+                hi = pos;
+            }
+            else
+            {
+                auto const pos = lo + step - 1;
+                if (!pred(_key_at(pos))) { hi = pos; break; }
+                lo = pos + 1;
+            }
+        }
+        return {lo, hi};
+    }
+
+    template <bool Upper, bool Backward, typename K>
+    iterator _bound_near(K const& key, const_iterator first, const_iterator last)
+    {
+        auto const [lo, hi] = _gallop<Upper, Backward>(key, first, last);
+        return _bound_in<Upper>(key, std::next(_container.begin(), lo), std::next(_container.begin(), hi));
+    }
+
+    // The three-way variant of _bound_near, which also tells whether the key is found.
+    template <bool Backward, typename K>
+    std::pair<iterator, bool> _three_way_search_near(K const& key, const_iterator first, const_iterator last)
+    {
+        auto const [lo, hi] = _gallop<false, Backward>(key, first, last);
+        auto result = _three_way_search(key, std::next(_container.cbegin(), lo), std::next(_container.cbegin(), hi));
+        // the bound may be the probe where galloping stopped
+        if (!result.second && result.first == std::next(_container.begin(), hi) && result.first != _mutable(last))
+        {
+            result.second = this->_comp()(key, _key_at(hi)) == 0;
+        }
+        return result;
+    }
+
+    template <typename InputIterator>
+    using _lookup_key_t = std::conditional_t<detail::is_transparent_v<Compare>, detail::remove_cvref_t<decltype(*std::declval<InputIterator&>())>, key_type>;
+
+    // Searches each key by exponential search from the result of the previous key, those are sorted.
+    template <bool Upper, typename InputIterator, typename F>
+    void _bound_galloping(InputIterator first, InputIterator last, F f)
+    {
+        using K = _lookup_key_t<InputIterator>;
+
+        size_type prev = 0;
+        for (; first != last; ++first)
+        {
+            K const& key = *first;
+            auto itr = _bound_near<Upper, false>(key, std::next(_container.begin(), prev), _container.end());
+            prev = static_cast<size_type>(std::distance(_container.begin(), itr));
+            f(key, itr);
+        }
+    }
+
+    // Searches a group of keys at once, interleaving their steps of branchless binary search.
+    // The next probe of each search is prefetched, and it is loaded while the other searches step, so that their cache misses overlap.
+    template <bool Upper, typename InputIterator, typename F>
+    void _bound_interleaved(InputIterator first, InputIterator last, F f)
+    {
+        using K = _lookup_key_t<InputIterator>;
+        constexpr std::size_t group = 16;
+
+        // Nothing to overlap when the elements stay in cache.
+        if (size() * sizeof(value_type) <= (1u << 18))
+        {
+            for (; first != last; ++first)
+            {
+                K const& key = *first;
+                f(key, _bound<Upper>(key));
+            }
+            return;
+        }
+
+        std::vector<K> keys;
+        keys.reserve(group);
+        std::array<size_type, group> lo;
+        std::array<size_type, group> n;
+        while (first != last)
+        {
+            keys.clear();
+            for (; first != last && keys.size() < group; ++first) { keys.emplace_back(*first); }
+
+            for (size_type i = 0; i < keys.size(); ++i)
+            {
+                auto [l, h] = _search_range<Upper>(keys[i]);
+                lo[i] = static_cast<size_type>(std::distance(_container.begin(), l));
+                n[i] = static_cast<size_type>(std::distance(l, h));
+                if (n[i] > 1) { _prefetch_at(lo[i] + n[i] / 2); }
+            }
+
+            for (bool active = true; active; )
+            {
+                active = false;
+                for (size_type i = 0; i < keys.size(); ++i)
+                {
+                    if (n[i] <= 1) { continue; }
+
+                    auto const half = n[i] / 2;
+                    lo[i] += static_cast<size_type>(detail::bound_predicate<K, Compare, Upper>{keys[i], _comp()}(_key_at(lo[i] + half))) * half;
+                    n[i] -= half;
+                    if (n[i] > 1) { _prefetch_at(lo[i] + n[i] / 2); }
+                    active = true;
+                }
+            }
+
+            for (size_type i = 0; i < keys.size(); ++i)
+            {
+                auto const pos = lo[i] + static_cast<size_type>(n[i] == 1 && detail::bound_predicate<K, Compare, Upper>{keys[i], _comp()}(_key_at(lo[i])));
+                f(keys[i], std::next(_container.begin(), pos));
+            }
+        }
+    }
+
+    template <bool Upper, typename InputIterator, typename F>
+    void _bound_many(range_order order, InputIterator first, InputIterator last, F f)
+    {
+        _merge_pending();
+        if (order == range_order::sorted || order == range_order::unique_sorted)
+        {
+            _bound_galloping<Upper>(first, last, f);
+        }
+        else
+        {
+            _bound_interleaved<Upper>(first, last, f);
+        }
+    }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator lower_bound_many(InputIterator first, InputIterator last, OutputIterator out) { return lower_bound_many(range_order::no_ordered, first, last, out); }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator lower_bound_many(InputIterator first, InputIterator last, OutputIterator out) const { return lower_bound_many(range_order::no_ordered, first, last, out); }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator lower_bound_many(range_order order, InputIterator first, InputIterator last, OutputIterator out)
+    {
+        _bound_many<false>(order, first, last, [&](auto const&, iterator itr) { *out++ = itr; });
+        return out;
+    }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator lower_bound_many(range_order order, InputIterator first, InputIterator last, OutputIterator out) const
+    {
+        const_cast<_binary_flat_tree_base*>(this)->template _bound_many<false>(order, first, last, [&](auto const&, iterator itr) { *out++ = const_iterator{itr}; });
+        return out;
+    }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator find_many(InputIterator first, InputIterator last, OutputIterator out) { return find_many(range_order::no_ordered, first, last, out); }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator find_many(InputIterator first, InputIterator last, OutputIterator out) const { return find_many(range_order::no_ordered, first, last, out); }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator find_many(range_order order, InputIterator first, InputIterator last, OutputIterator out)
+    {
+        _bound_many<false>(order, first, last, [&](auto const& key, iterator itr) { *out++ = itr == _container.end() || _vcomp()(key, *itr) ? _container.end() : itr; });
+        return out;
+    }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator find_many(range_order order, InputIterator first, InputIterator last, OutputIterator out) const
+    {
+        auto self = const_cast<_binary_flat_tree_base*>(this);
+        self->template _bound_many<false>(order, first, last, [&](auto const& key, iterator itr) { *out++ = const_iterator{itr == self->end() || _vcomp()(key, *itr) ? self->end() : itr}; });
+        return out;
+    }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator contains_many(InputIterator first, InputIterator last, OutputIterator out) const { return contains_many(range_order::no_ordered, first, last, out); }
+
+    // extension
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator contains_many(range_order order, InputIterator first, InputIterator last, OutputIterator out) const
+    {
+        auto self = const_cast<_binary_flat_tree_base*>(this);
+        self->template _bound_many<false>(order, first, last, [&](auto const& key, iterator itr) { *out++ = !(itr == self->end() || _vcomp()(key, *itr)); });
+        return out;
+    }
+
+    // Searches from the position of the previous search, or from scratch if the container is mutated since then.
+    template <typename K>
+    iterator _seek(size_type& pos, std::size_t& epoch, K const& key)
+    {
+        _merge_pending();
+        auto itr = [&]
+        {
+            if (epoch != _epoch.value)
+            {
+                epoch = _epoch.value;
+                return _lower_bound(key);
+            }
+            if (pos > 0 && !detail::bound_predicate<K, Compare, false>{key, _comp()}(_key_at(pos - 1)))
+            {
+                return _bound_near<false, true>(key, _container.cbegin(), std::next(_container.cbegin(), pos - 1));
+            }
+            return _bound_near<false, false>(key, std::next(_container.cbegin(), pos), _container.cend());
+        }();
+        pos = static_cast<size_type>(std::distance(_container.begin(), itr));
+        return itr;
+    }
+
+    template <bool Const>
+    class _cursor
+    {
+        friend _binary_flat_tree_base;
+
+        using _tree_type = std::conditional_t<Const, _binary_flat_tree_base const, _binary_flat_tree_base>;
+        using _iterator = std::conditional_t<Const, const_iterator, iterator>;
+
+        _tree_type* _tree;
+        std::size_t _epoch;
+        size_type _pos = 0;
+
+        explicit _cursor(_tree_type* tree) noexcept : _tree{tree}, _epoch{tree->_epoch.value} { }
+
+        template <typename K>
+        _iterator _seek(K const& key) { return const_cast<_binary_flat_tree_base*>(_tree)->_seek(_pos, _epoch, key); }
+
+        template <typename K>
+        _iterator _find(K const& key)
+        {
+            _iterator itr = _seek(key);
+            return itr == _tree->end() || _tree->_vcomp()(key, *itr) ? _tree->end() : itr;
+        }
+
+    public:
+        _iterator seek(key_type const& key) { return _seek(key); }
+
+        template <typename K>
+        enable_if_transparent<K, _iterator> seek(K const& key) { return _seek(key); }
+
+        _iterator find(key_type const& key) { return _find(key); }
+
+        template <typename K>
+        enable_if_transparent<K, _iterator> find(K const& key) { return _find(key); }
+    };
+
+    using cursor = _cursor<false>;
+    using const_cursor = _cursor<true>;
+
+    // extension
+    cursor make_cursor() noexcept { return cursor{this}; }
+
+    // extension
+    const_cursor make_cursor() const noexcept { return const_cursor{this}; }
+
     key_compare key_comp() const { return this->_comp(); }
     auto value_comp() { return static_cast<typename Subclass::value_compare>(_vcomp()); }
+    // extension
+    auto const& lookup_index() const noexcept { return _index(); }
 };
 
 } // namespace flat_map::detail
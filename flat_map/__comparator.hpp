@@ -6,6 +6,8 @@
 #include <type_traits>
 #include <utility>
 
+#include "flat_map/__config.hpp"
+
 namespace flat_map::detail
 {
 
@@ -33,4 +35,45 @@ struct comparator_store<Compare, std::enable_if_t<std::is_class_v<Compare> && !s
     auto& _comp() { return *static_cast<Compare*>(this); }
 };
 
+// Three-way comparator returns a value to be compared with 0, as same as `<=>`.
+// It's opted in by `is_three_way` member type, like `is_transparent`.
+template <typename Compare, typename = void>
+struct is_three_way : public std::false_type {};
+
+template <typename Compare>
+struct is_three_way<Compare, std::void_t<typename Compare::is_three_way>> : public std::true_type {};
+
+#ifdef FLAT_MAP_HAS_THREE_WAY_COMPARISON
+template <>
+struct is_three_way<std::compare_three_way, void> : public std::true_type {};
+#endif
+
+template <typename Compare>
+inline constexpr bool is_three_way_v = is_three_way<Compare>{};
+
+// Calls `comp` as less-than, whichever it is three-way or not.
+template <typename Compare, typename T, typename U>
+constexpr bool invoke_less(Compare const& comp, T const& lhs, U const& rhs)
+{
+    if constexpr (is_three_way_v<Compare>) { return comp(lhs, rhs) < 0; }
+    else { return comp(lhs, rhs); }
+}
+
+template <typename Compare>
+struct three_way_less
+{
+    Compare comp;
+
+    three_way_less(Compare const& comp) : comp{comp} { }
+
+    explicit operator Compare() const { return comp; }
+
+    template <typename T, typename U>
+    bool operator()(T const& lhs, U const& rhs) const { return comp(lhs, rhs) < 0; }
+};
+
+// Less-than predicate of Compare.
+template <typename Compare>
+using less_of_t = std::conditional_t<is_three_way_v<Compare>, three_way_less<Compare>, Compare>;
+
 } // namespace flat_map::detail
@@ -26,5 +26,12 @@ template <typename T> inline constexpr bool Name = Name ## _body<T Params>::chec
 } // namespace flat_map::detail
 
 FLAT_MAP_DEFINE_CONCEPT(Reservable, T, (T c, size_t n), c.reserve(n));
+FLAT_MAP_DEFINE_CONCEPT(Contiguous, T, (T c), c.data());
+FLAT_MAP_DEFINE_CONCEPT(Invalidatable, T, (T c), c.invalidate());
+FLAT_MAP_DEFINE_CONCEPT(Memoizable, T, (T c, size_t n), c.memoize(n));
+FLAT_MAP_DEFINE_CONCEPT(Filtering, T, (T c, size_t n), c.may_contain(n, n));
+FLAT_MAP_DEFINE_CONCEPT(Patchable, T, (T c, size_t n), c.erased(n, n));
+FLAT_MAP_DEFINE_CONCEPT(Buffering, T, (T c), c.pending());
+FLAT_MAP_DEFINE_CONCEPT(Segmented, T, (T c, size_t n), c.segment_data(n));
 
 } // namespace flat_map::concepts
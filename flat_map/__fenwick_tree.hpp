@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace flat_map::detail
+{
+
+// Prefix sums of the number of elements in each segment, which translates between positions of elements and segments in O(log n).
+template <typename Allocator>
+class fenwick_tree
+{
+public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // 1-based
+    std::vector<size_type, Allocator> _tree;
+
+public:
+    fenwick_tree() = default;
+    explicit fenwick_tree(Allocator const& alloc) : _tree(alloc) { }
+
+    template <typename Alloc>
+    fenwick_tree(fenwick_tree const& other, Alloc const& alloc) : _tree(other._tree, Allocator(alloc)) { }
+
+    template <typename Alloc>
+    fenwick_tree(fenwick_tree&& other, Alloc const& alloc) : _tree(std::move(other._tree), Allocator(alloc)) { }
+
+    // Builds from the number of elements of `n` segments given by `count(i)`.
+    template <typename F>
+    void assign(size_type n, F count)
+    {
+        _tree.assign(n + 1, 0);
+        for (size_type i = 1; i <= n; ++i)
+        {
+            _tree[i] += count(i - 1);
+            if (auto const j = i + (i & (~i + 1)); j <= n) { _tree[j] += _tree[i]; }
+        }
+    }
+
+    void clear() noexcept { _tree.clear(); }
+
+    void add(size_type i, difference_type delta) noexcept
+    {
+        for (++i; i < _tree.size(); i += i & (~i + 1)) { _tree[i] += static_cast<size_type>(delta); }
+    }
+
+    // Number of elements in segments before `i`.
+    size_type prefix(size_type i) const noexcept
+    {
+        size_type r = 0;
+        for (; i > 0; i &= i - 1) { r += _tree[i]; }
+        return r;
+    }
+
+    // The segment which contains the element at `rank`, and the offset of the element in the segment.
+    std::pair<size_type, size_type> find(size_type rank) const noexcept
+    {
+        size_type step = 1;
+        while (step < _tree.size()) { step <<= 1; }
+
+        size_type i = 0;
+        for (step >>= 1; step > 0; step >>= 1)
+        {
+            if (i + step < _tree.size() && _tree[i + step] <= rank)
+            {
+                i += step;
+                rank -= _tree[i];
+            }
+        }
+        return {i, rank};
+    }
+
+    void swap(fenwick_tree& other) noexcept { _tree.swap(other._tree); }
+};
+
+} // namespace flat_map::detail
@@ -33,9 +33,9 @@ FLATMAP_END_STD
 
 namespace flat_map
 {
-template <typename Key, typename T, typename Compare, typename Container> class flat_map;
-template <typename Key, typename T, typename Compare, typename Container> class flat_multimap;
-template <typename Key, typename Compare, typename Container> class flat_set;
-template <typename Key, typename Compare, typename Container> class flat_multiset;
+template <typename Key, typename T, typename Compare, typename Container, typename Index> class flat_map;
+template <typename Key, typename T, typename Compare, typename Container, typename Index> class flat_multimap;
+template <typename Key, typename Compare, typename Container, typename Index> class flat_set;
+template <typename Key, typename Compare, typename Container, typename Index> class flat_multiset;
 template <typename... Sequences> class tied_sequence;
 } // namespace flat_map
@@ -14,6 +14,13 @@ namespace flat_map
 namespace detail
 {
 
+inline void prefetch([[maybe_unused]] void const* addr) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr);
+#endif
+}
+
 template <typename AllocatorTuple>
 struct fake_allocator : private AllocatorTuple
 {
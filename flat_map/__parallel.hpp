@@ -0,0 +1,180 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "flat_map/execution.hpp"
+
+namespace flat_map::detail
+{
+
+// Threads worth running over `n` elements, where each thread takes at least 16K elements.
+inline std::size_t thread_count(parallel_policy policy, std::size_t n) noexcept
+{
+    std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+    return std::max<std::size_t>(std::min<std::size_t>(threads, n >> 14), 1);
+}
+
+// Runs fn(0), ..., fn(tasks - 1) on threads, and rethrows the first exception after all of them finished.
+template <typename F>
+void parallel_for(std::size_t tasks, F const& fn)
+{
+    std::vector<std::exception_ptr> errors(tasks);
+    auto run = [&](std::size_t t)
+    {
+        try { fn(t); }
+        catch (...) { errors[t] = std::current_exception(); }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(tasks);
+    for (std::size_t t = 1; t < tasks; ++t)
+    {
+        try { workers.emplace_back(run, t); }
+        catch (...) { run(t); }
+    }
+    run(0);
+    for (auto& worker : workers) { worker.join(); }
+    for (auto& error : errors)
+    {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
+
+template <typename T>
+void parallel_move(T* first, T* last, T* out, std::size_t threads)
+{
+    auto const n = static_cast<std::size_t>(last - first);
+    parallel_for(threads, [&](std::size_t t)
+    {
+        std::move(first + n * t / threads, first + n * (t + 1) / threads, out + n * t / threads);
+    });
+}
+
+// Number of elements from `a` in the first `k` elements of the stable merge of `a` and `b`.
+template <typename T, typename Compare>
+std::size_t merge_corank(T const* a, std::size_t na, T const* b, std::size_t nb, std::size_t k, Compare const& comp)
+{
+    auto lo = k > nb ? k - nb : 0;
+    auto hi = std::min(k, na);
+    while (lo < hi)
+    {
+        auto const mid = lo + (hi - lo) / 2;
+        if (!comp(b[k - mid - 1], a[mid])) { lo = mid + 1; }
+        else { hi = mid; }
+    }
+    return lo;
+}
+
+// Stable merge of sorted runs [bounds[2i], bounds[2i+1]) and [bounds[2i+1], bounds[2i+2]) of `src` into the same positions of `dst`.
+// The output is split evenly over threads, and where each part starts in the runs is found before any element is moved, since the search reads `src`.
+template <typename T, typename Compare>
+void parallel_merge_runs(T* src, std::vector<std::size_t> const& bounds, T* dst, std::size_t threads, Compare const& comp)
+{
+    auto const n = bounds.back();
+    auto const run = [&](std::size_t r)
+    {
+        auto const first = bounds[r];
+        auto const mid = std::min(bounds[r + 1], n);
+        auto const last = r + 2 < bounds.size() ? bounds[r + 2] : mid;
+        return std::make_tuple(first, mid, last);
+    };
+
+    // ranks[t] is the number of elements from the former run before the start of the t-th part, in the pair of runs containing it.
+    std::vector<std::size_t> ranks(threads + 1);
+    for (std::size_t t = 0, r = 0; t < threads; ++t)
+    {
+        auto const from = n * t / threads;
+        while (std::get<2>(run(r)) <= from) { r += 2; }
+        auto const [first, mid, last] = run(r);
+        ranks[t] = merge_corank(src + first, mid - first, src + mid, last - mid, from - first, comp);
+    }
+
+    parallel_for(threads, [&](std::size_t t)
+    {
+        auto const from = n * t / threads;
+        auto const to = n * (t + 1) / threads;
+        for (std::size_t r = 0; r + 1 < bounds.size(); r += 2)
+        {
+            auto const [first, mid, last] = run(r);
+            if (last <= from || to <= first) { continue; }
+
+            auto const a = src + first, b = src + mid;
+            auto const k0 = std::max(from, first) - first, k1 = std::min(to, last) - first;
+            auto const i0 = first <= from ? ranks[t] : 0;
+            auto const i1 = to < last ? ranks[t + 1] : mid - first;
+            std::merge(std::make_move_iterator(a + i0), std::make_move_iterator(a + i1),
+                       std::make_move_iterator(b + (k0 - i0)), std::make_move_iterator(b + (k1 - i1)),
+                       dst + first + k0, comp);
+        }
+    });
+}
+
+// Stable sort of [first, last) with `buffer` of the same size, where `sort(first, last)` sorts each part on a thread, and parts are merged by pairs.
+// Returns where the sorted elements are, either `first` or `buffer`.
+template <typename T, typename Sort, typename Compare>
+T* parallel_stable_sort(T* first, T* last, T* buffer, std::size_t threads, Sort const& sort, Compare const& comp)
+{
+    auto const n = static_cast<std::size_t>(last - first);
+    std::vector<std::size_t> bounds;
+    for (std::size_t t = 0; t <= threads; ++t) { bounds.push_back(n * t / threads); }
+    parallel_for(threads, [&](std::size_t t) { sort(first + bounds[t], first + bounds[t + 1]); });
+
+    auto src = first, dst = buffer;
+    while (bounds.size() > 2)
+    {
+        parallel_merge_runs(src, bounds, dst, threads, comp);
+        std::vector<std::size_t> merged;
+        for (std::size_t r = 0; r < bounds.size(); r += 2) { merged.push_back(bounds[r]); }
+        if (merged.back() != n) { merged.push_back(n); }
+        bounds = std::move(merged);
+        std::swap(src, dst);
+    }
+    return src;
+}
+
+// Moves the first element of each run of equivalent elements in sorted [first, last) to `out`, and returns the number of them.
+// Parts for threads begin at the start of runs, so that they are deduplicated independently once their offsets are counted.
+template <typename T, typename Equal>
+std::size_t parallel_unique_move(T* first, T* last, T* out, std::size_t threads, Equal const& eq)
+{
+    auto const n = static_cast<std::size_t>(last - first);
+    std::vector<std::size_t> bounds{0};
+    for (std::size_t t = 1; t < threads; ++t)
+    {
+        auto b = std::max(n * t / threads, bounds.back());
+        while (b != 0 && b < n && eq(first[b - 1], first[b])) { ++b; }
+        bounds.push_back(b);
+    }
+    bounds.push_back(n);
+
+    std::vector<std::size_t> offsets(threads + 1);
+    parallel_for(threads, [&](std::size_t t)
+    {
+        std::size_t count = 0;
+        for (auto i = bounds[t]; i < bounds[t + 1]; ++i) { count += static_cast<std::size_t>(i == bounds[t] || !eq(first[i - 1], first[i])); }
+        offsets[t + 1] = count;
+    });
+    for (std::size_t t = 0; t < threads; ++t) { offsets[t + 1] += offsets[t]; }
+
+    parallel_for(threads, [&](std::size_t t)
+    {
+        auto o = offsets[t];
+        for (auto i = bounds[t]; i < bounds[t + 1]; ++i)
+        {
+            if (i == bounds[t] || !eq(out[o - 1], first[i])) { out[o++] = std::move(first[i]); }
+        }
+    });
+    return offsets.back();
+}
+
+} // namespace flat_map::detail
@@ -31,6 +31,24 @@ using iter_val_t = typename std::iterator_traits<InputIterator>::value_type::sec
 template <typename InputIterator, typename... Args>
 using iter_cont_t = std::vector<std::pair<iter_key_t<InputIterator>, iter_val_t<InputIterator>>, Args...>;
 
+template <typename Compare, typename = void>
+struct is_transparent : public std::false_type {};
+
+template <typename Compare>
+struct is_transparent<Compare, std::void_t<typename Compare::is_transparent>> : public std::true_type {};
+
+template <typename Compare>
+inline constexpr bool is_transparent_v = is_transparent<Compare>{};
+
+template <typename T>
+struct is_tied_sequence : public std::false_type {};
+
+template <typename... Sequences>
+struct is_tied_sequence<tied_sequence<Sequences...>> : public std::true_type {};
+
+template <typename T>
+inline constexpr bool is_tied_sequence_v = is_tied_sequence<T>{};
+
 template <typename T>
 using remove_cvref = std::remove_reference<std::remove_cv_t<T>>;
 
@@ -0,0 +1,645 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flat_map/__config.hpp"
+#include "flat_map/__fenwick_tree.hpp"
+
+namespace flat_map
+{
+
+// Sequence of contiguous blocks of fixed capacity, so that insertion and erasure shift only a block.
+// A full block is split into halves, and a block is merged into its neighbour once both fit in a half.
+template <typename T, typename Allocator = std::allocator<T>, std::size_t BlockBytes = 4096>
+class chunked_vector
+{
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = value_type const&;
+    using pointer                = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+
+    static constexpr size_type block_capacity = std::max<size_type>(BlockBytes / sizeof(T), 4);
+
+private:
+    template <bool Const>
+    class _iterator
+    {
+        friend class chunked_vector;
+
+        template <bool>
+        friend class _iterator;
+
+        using container_type = std::conditional_t<Const, chunked_vector const, chunked_vector>;
+
+        container_type* _c = nullptr;
+        size_type _block = 0;
+        size_type _offset = 0;
+
+        _iterator(container_type* c, size_type block, size_type offset) noexcept : _c{c}, _block{block}, _offset{offset} { }
+
+    public:
+        using difference_type   = chunked_vector::difference_type;
+        using value_type        = chunked_vector::value_type;
+        using pointer           = std::conditional_t<Const, value_type const*, value_type*>;
+        using reference         = std::conditional_t<Const, value_type const&, value_type&>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        _iterator() = default;
+
+        template <bool C, typename = std::enable_if_t<Const && !C>>
+        _iterator(_iterator<C> const& other) noexcept : _c{other._c}, _block{other._block}, _offset{other._offset} { }
+
+        reference operator*() const { return _c->_blocks[_block][_offset]; }
+        pointer operator->() const { return std::addressof(_c->_blocks[_block][_offset]); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        _iterator& operator++()
+        {
+            if (++_offset == _c->_blocks[_block].size())
+            {
+                ++_block;
+                _offset = 0;
+            }
+            return *this;
+        }
+
+        _iterator operator++(int)
+        {
+            auto copy = *this;
+            operator++();
+            return copy;
+        }
+
+        _iterator& operator--()
+        {
+            if (_offset == 0) { _offset = _c->_blocks[--_block].size(); }
+            --_offset;
+            return *this;
+        }
+
+        _iterator operator--(int)
+        {
+            auto copy = *this;
+            operator--();
+            return copy;
+        }
+
+        _iterator& operator+=(difference_type n)
+        {
+            auto const offset = static_cast<difference_type>(_offset) + n;
+            if (_block < _c->_blocks.size() && 0 <= offset && offset < static_cast<difference_type>(_c->_blocks[_block].size()))
+            {
+                _offset = static_cast<size_type>(offset);
+            }
+            else
+            {
+                std::tie(_block, _offset) = _c->_position(static_cast<size_type>(static_cast<difference_type>(_c->_rank(_block, _offset)) + n));
+            }
+            return *this;
+        }
+
+        _iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend _iterator operator+(_iterator itr, difference_type n) { return itr += n; }
+        friend _iterator operator+(difference_type n, _iterator itr) { return itr += n; }
+        friend _iterator operator-(_iterator itr, difference_type n) { return itr -= n; }
+
+        template <bool C>
+        difference_type operator-(_iterator<C> const& other) const
+        {
+            if (_block == other._block) { return static_cast<difference_type>(_offset) - static_cast<difference_type>(other._offset); }
+            return static_cast<difference_type>(_c->_rank(_block, _offset)) - static_cast<difference_type>(_c->_rank(other._block, other._offset));
+        }
+
+        template <bool C> bool operator==(_iterator<C> const& other) const noexcept { return _c == other._c && _block == other._block && _offset == other._offset; }
+        template <bool C> bool operator!=(_iterator<C> const& other) const noexcept { return !(*this == other); }
+        template <bool C> bool operator<(_iterator<C> const& other) const noexcept { return _block < other._block || (_block == other._block && _offset < other._offset); }
+        template <bool C> bool operator>(_iterator<C> const& other) const noexcept { return other < *this; }
+        template <bool C> bool operator<=(_iterator<C> const& other) const noexcept { return !(other < *this); }
+        template <bool C> bool operator>=(_iterator<C> const& other) const noexcept { return !(*this < other); }
+    };
+
+public:
+    using iterator               = _iterator<false>;
+    using const_iterator         = _iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using _block_type = std::vector<T, Allocator>;
+    using _block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_block_type>;
+    using _size_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
+
+    static constexpr size_type _fill = block_capacity - block_capacity / 4;
+
+    // Blocks are never empty.
+    std::vector<_block_type, _block_allocator> _blocks;
+    // Translates between positions and blocks.
+    detail::fenwick_tree<_size_allocator> _tree;
+    size_type _size = 0;
+
+    _block_type _new_block()
+    {
+        _block_type block(get_allocator());
+        block.reserve(block_capacity);
+        return block;
+    }
+
+    void _rebuild_tree()
+    {
+        _tree.assign(_blocks.size(), [this](size_type i) { return _blocks[i].size(); });
+    }
+
+    size_type _rank(size_type block, size_type offset) const noexcept
+    {
+        if (block == _blocks.size()) { return _size; }
+        return _tree.prefix(block) + offset;
+    }
+
+    std::pair<size_type, size_type> _position(size_type rank) const noexcept
+    {
+        if (rank >= _size) { return {_blocks.size(), 0}; }
+        return _tree.find(rank);
+    }
+
+    // Lays out elements over blocks filled to 3/4, which leaves room for insertion before a block is split.
+    template <typename InputIterator>
+    void _assign_blocks(InputIterator first, InputIterator last)
+    {
+        _blocks.clear();
+        _size = 0;
+        for (; first != last; ++first)
+        {
+            if (_blocks.empty() || _blocks.back().size() == _fill) { _blocks.push_back(_new_block()); }
+            _blocks.back().emplace_back(*first);
+            ++_size;
+        }
+        _rebuild_tree();
+    }
+
+    // Copies or moves the elements block by block, which keeps the layout of `other`.
+    template <typename Other>
+    void _assign_layout(Other&& other)
+    {
+        std::vector<_block_type, _block_allocator> blocks(_blocks.get_allocator());
+        blocks.reserve(other._blocks.size());
+        for (auto& block : other._blocks)
+        {
+            blocks.push_back(_new_block());
+            if constexpr (std::is_lvalue_reference_v<Other>) { blocks.back().assign(block.begin(), block.end()); }
+            else { blocks.back().assign(std::make_move_iterator(block.begin()), std::make_move_iterator(block.end())); }
+        }
+        _blocks.swap(blocks);
+        _size = other._size;
+        _rebuild_tree();
+    }
+
+    std::vector<T, Allocator> _elements()
+    {
+        std::vector<T, Allocator> elements(get_allocator());
+        elements.reserve(_size);
+        for (auto& block : _blocks) { std::move(block.begin(), block.end(), std::back_inserter(elements)); }
+        return elements;
+    }
+
+    iterator _insert_value(const_iterator pos, T&& value)
+    {
+        auto block = pos._block;
+        auto offset = pos._offset;
+        if (block == _blocks.size())
+        {
+            if (_blocks.empty() || _blocks.back().size() == block_capacity)
+            {
+                // Appending starts a new block rather than splitting the last one.
+                _blocks.push_back(_new_block());
+                _blocks.back().push_back(std::move(value));
+                ++_size;
+                _rebuild_tree();
+                return iterator{this, _blocks.size() - 1, 0};
+            }
+            block = _blocks.size() - 1;
+            offset = _blocks.back().size();
+        }
+
+        if (_blocks[block].size() == block_capacity)
+        {
+            auto const half = block_capacity / 2;
+            auto upper = _new_block();
+            std::move(_blocks[block].begin() + static_cast<difference_type>(half), _blocks[block].end(), std::back_inserter(upper));
+            _blocks[block].erase(_blocks[block].begin() + static_cast<difference_type>(half), _blocks[block].end());
+            _blocks.insert(_blocks.begin() + static_cast<difference_type>(block + 1), std::move(upper));
+            if (offset > half)
+            {
+                ++block;
+                offset -= half;
+            }
+            _blocks[block].insert(_blocks[block].begin() + static_cast<difference_type>(offset), std::move(value));
+            ++_size;
+            _rebuild_tree();
+        }
+        else
+        {
+            _blocks[block].insert(_blocks[block].begin() + static_cast<difference_type>(offset), std::move(value));
+            ++_size;
+            _tree.add(block, 1);
+        }
+        return iterator{this, block, offset};
+    }
+
+    // Removes the empty block, or merges the block into a neighbour if both fit in a half, and tells whether blocks are changed.
+    bool _coalesce(size_type block)
+    {
+        if (block >= _blocks.size()) { return false; }
+        if (_blocks[block].empty())
+        {
+            _blocks.erase(_blocks.begin() + static_cast<difference_type>(block));
+            return true;
+        }
+
+        auto merge = [this](size_type lower)
+        {
+            auto& upper = _blocks[lower + 1];
+            std::move(upper.begin(), upper.end(), std::back_inserter(_blocks[lower]));
+            _blocks.erase(_blocks.begin() + static_cast<difference_type>(lower + 1));
+        };
+        if (block + 1 < _blocks.size() && _blocks[block].size() + _blocks[block + 1].size() <= block_capacity / 2)
+        {
+            merge(block);
+            return true;
+        }
+        if (block > 0 && _blocks[block - 1].size() + _blocks[block].size() <= block_capacity / 2)
+        {
+            merge(block - 1);
+            return true;
+        }
+        return false;
+    }
+
+public:
+    chunked_vector() = default;
+
+    explicit chunked_vector(allocator_type const& alloc) : _blocks(_block_allocator(alloc)), _tree(_size_allocator(alloc)) { }
+
+    chunked_vector(size_type count, value_type const& value, allocator_type const& alloc = allocator_type())
+      : chunked_vector(alloc)
+    {
+        assign(count, value);
+    }
+
+    explicit chunked_vector(size_type count, allocator_type const& alloc = allocator_type())
+      : chunked_vector(alloc)
+    {
+        std::vector<T, Allocator> elements(count, alloc);
+        _assign_blocks(std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+    }
+
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    chunked_vector(InputIterator first, InputIterator last, allocator_type const& alloc = allocator_type())
+      : chunked_vector(alloc)
+    {
+        assign(first, last);
+    }
+
+    chunked_vector(chunked_vector const& other)
+      : chunked_vector(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) { }
+
+    chunked_vector(chunked_vector const& other, allocator_type const& alloc)
+      : chunked_vector(alloc)
+    {
+        _assign_layout(other);
+    }
+
+    chunked_vector(chunked_vector&& other) noexcept
+      : _blocks(std::move(other._blocks)), _tree(std::move(other._tree)), _size{std::exchange(other._size, 0)}
+    {
+        other.clear();
+    }
+
+    chunked_vector(chunked_vector&& other, allocator_type const& alloc)
+      : chunked_vector(alloc)
+    {
+        _assign_layout(std::move(other));
+        other.clear();
+    }
+
+    chunked_vector(std::initializer_list<value_type> init, allocator_type const& alloc = allocator_type())
+      : chunked_vector(init.begin(), init.end(), alloc) { }
+
+    chunked_vector& operator=(chunked_vector const& other)
+    {
+        if (this != &other) { _assign_layout(other); }
+        return *this;
+    }
+
+    chunked_vector& operator=(chunked_vector&& other) noexcept(std::is_nothrow_move_assignable_v<std::vector<_block_type, _block_allocator>>)
+    {
+        _blocks = std::move(other._blocks);
+        _tree = std::move(other._tree);
+        _size = std::exchange(other._size, 0);
+        other.clear();
+        return *this;
+    }
+
+    chunked_vector& operator=(std::initializer_list<value_type> ilist)
+    {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    void assign(size_type count, value_type const& value)
+    {
+        std::vector<T, Allocator> elements(count, value, get_allocator());
+        _assign_blocks(std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+    }
+
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    void assign(InputIterator first, InputIterator last) { _assign_blocks(first, last); }
+
+    void assign(std::initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(_blocks.get_allocator()); }
+
+    reference at(size_type pos)
+    {
+        if (!(pos < size())) { throw std::out_of_range{"chunked_vector::at"}; }
+        return operator[](pos);
+    }
+
+    const_reference at(size_type pos) const { return const_cast<chunked_vector*>(this)->at(pos); }
+
+    reference operator[](size_type pos)
+    {
+        auto const [block, offset] = _position(pos);
+        return _blocks[block][offset];
+    }
+
+    const_reference operator[](size_type pos) const { return const_cast<chunked_vector*>(this)->operator[](pos); }
+
+    reference front() { return _blocks.front().front(); }
+    const_reference front() const { return _blocks.front().front(); }
+    reference back() { return _blocks.back().back(); }
+    const_reference back() const { return _blocks.back().back(); }
+
+    iterator begin() noexcept { return iterator{this, 0, 0}; }
+    const_iterator begin() const noexcept { return const_iterator{this, 0, 0}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator{this, _blocks.size(), 0}; }
+    const_iterator end() const noexcept { return const_iterator{this, _blocks.size(), 0}; }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+    size_type max_size() const noexcept { return _block_type(get_allocator()).max_size(); }
+
+    // Number of elements which the blocks can hold.
+    size_type capacity() const noexcept { return _blocks.size() * block_capacity; }
+
+    void shrink_to_fit()
+    {
+        auto elements = _elements();
+        _assign_blocks(std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+    }
+
+    void clear() noexcept
+    {
+        _blocks.clear();
+        _tree.clear();
+        _size = 0;
+    }
+
+    // extension
+    size_type segment_count() const noexcept { return _blocks.size(); }
+    // extension
+    size_type segment_size(size_type block) const noexcept { return _blocks[block].size(); }
+    // extension
+    T* segment_data(size_type block) noexcept { return _blocks[block].data(); }
+    // extension
+    T const* segment_data(size_type block) const noexcept { return _blocks[block].data(); }
+    // extension
+    std::pair<size_type, size_type> segment_position(const_iterator pos) const noexcept { return {pos._block, pos._offset}; }
+    // extension
+    iterator segment_iterator(size_type block, size_type offset) noexcept
+    {
+        if (block < _blocks.size() && offset == _blocks[block].size()) { return iterator{this, block + 1, 0}; }
+        return iterator{this, block, offset};
+    }
+
+    iterator insert(const_iterator pos, value_type const& value) { return _insert_value(pos, value_type(value)); }
+
+    iterator insert(const_iterator pos, value_type&& value) { return _insert_value(pos, std::move(value)); }
+
+    iterator insert(const_iterator pos, size_type count, value_type const& value)
+    {
+        std::vector<T, Allocator> values(count, value, get_allocator());
+        return insert(pos, std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+    }
+
+    // Elements which fit in the block at `pos` (or in a half of it) are inserted there, and others are laid out over new blocks between the halves of it.
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    iterator insert(const_iterator pos, InputIterator first, InputIterator last)
+    {
+        auto const rank = _rank(pos._block, pos._offset);
+        std::vector<T, Allocator> values(first, last, get_allocator());
+        if (values.empty()) { return iterator{this, pos._block, pos._offset}; }
+
+        auto block = pos._block;
+        auto offset = pos._offset;
+        if (block == _blocks.size() && block != 0)
+        {
+            --block;
+            offset = _blocks[block].size();
+        }
+
+        _size += values.size();
+        if (block < _blocks.size() && values.size() <= block_capacity / 2)
+        {
+            auto const split = _blocks[block].size() + values.size() > block_capacity;
+            if (split)
+            {
+                auto const half = _blocks[block].size() / 2;
+                auto upper = _new_block();
+                std::move(_blocks[block].begin() + static_cast<difference_type>(half), _blocks[block].end(), std::back_inserter(upper));
+                _blocks[block].erase(_blocks[block].begin() + static_cast<difference_type>(half), _blocks[block].end());
+                _blocks.insert(_blocks.begin() + static_cast<difference_type>(block + 1), std::move(upper));
+                if (offset > half)
+                {
+                    ++block;
+                    offset -= half;
+                }
+            }
+            _blocks[block].insert(_blocks[block].begin() + static_cast<difference_type>(offset), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+            if (split) { _rebuild_tree(); }
+            else { _tree.add(block, static_cast<difference_type>(values.size())); }
+        }
+        else
+        {
+            // Spreads the elements evenly over the fewest blocks filled up to 3/4.
+            auto const count = (values.size() + _fill - 1) / _fill;
+            std::vector<_block_type, _block_allocator> blocks(_blocks.get_allocator());
+            blocks.reserve(count + 1);
+            for (size_type i = 0; i < count; ++i)
+            {
+                blocks.push_back(_new_block());
+                auto const lo = values.begin() + static_cast<difference_type>(values.size() * i / count);
+                auto const hi = values.begin() + static_cast<difference_type>(values.size() * (i + 1) / count);
+                blocks.back().assign(std::make_move_iterator(lo), std::make_move_iterator(hi));
+            }
+            if (block < _blocks.size() && offset != 0)
+            {
+                auto& head = _blocks[block];
+                if (offset != head.size())
+                {
+                    blocks.push_back(_new_block());
+                    std::move(head.begin() + static_cast<difference_type>(offset), head.end(), std::back_inserter(blocks.back()));
+                    head.erase(head.begin() + static_cast<difference_type>(offset), head.end());
+                }
+                ++block;
+            }
+            _blocks.insert(_blocks.begin() + static_cast<difference_type>(block), std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+
+            // The halves might be small enough to be merged into a neighbour.
+            _coalesce(block + blocks.size() - 1);
+            if (block != 0) { _coalesce(block - 1); }
+            _rebuild_tree();
+        }
+        auto const [b, o] = _position(rank);
+        return iterator{this, b, o};
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) { return _insert_value(pos, value_type(std::forward<Args>(args)...)); }
+
+    iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto const rank = _rank(first._block, first._offset);
+        auto const n = static_cast<size_type>(last - first);
+        if (n == 0) { return iterator{this, first._block, first._offset}; }
+
+        if (first._block == last._block)
+        {
+            auto& block = _blocks[first._block];
+            block.erase(block.begin() + static_cast<difference_type>(first._offset), block.begin() + static_cast<difference_type>(last._offset));
+            _size -= n;
+            if (_coalesce(first._block)) { _rebuild_tree(); }
+            else { _tree.add(first._block, -static_cast<difference_type>(n)); }
+        }
+        else
+        {
+            // Drops the tail of the first block, the whole blocks between, and the head of the last block.
+            auto& head = _blocks[first._block];
+            head.erase(head.begin() + static_cast<difference_type>(first._offset), head.end());
+            if (last._block < _blocks.size())
+            {
+                auto& tail = _blocks[last._block];
+                tail.erase(tail.begin(), tail.begin() + static_cast<difference_type>(last._offset));
+            }
+            _blocks.erase(_blocks.begin() + static_cast<difference_type>(first._block + 1), _blocks.begin() + static_cast<difference_type>(last._block));
+            _size -= n;
+            if (auto const next = first._block + 1; next < _blocks.size() && _blocks[next].empty())
+            {
+                _blocks.erase(_blocks.begin() + static_cast<difference_type>(next));
+            }
+            _coalesce(first._block);
+            _rebuild_tree();
+        }
+        auto const [block, offset] = _position(rank);
+        return iterator{this, block, offset};
+    }
+
+    void push_back(value_type const& value) { insert(end(), value); }
+
+    void push_back(value_type&& value) { insert(end(), std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+    void pop_back() { erase(std::prev(end())); }
+
+    void swap(chunked_vector& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value || std::allocator_traits<Allocator>::is_always_equal::value)
+    {
+        using std::swap;
+        swap(_blocks, other._blocks);
+        swap(_tree, other._tree);
+        swap(_size, other._size);
+    }
+};
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+bool operator==(chunked_vector<T, Allocator, BlockBytes> const& lhs, chunked_vector<T, Allocator, BlockBytes> const& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+bool operator!=(chunked_vector<T, Allocator, BlockBytes> const& lhs, chunked_vector<T, Allocator, BlockBytes> const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+bool operator<(chunked_vector<T, Allocator, BlockBytes> const& lhs, chunked_vector<T, Allocator, BlockBytes> const& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+bool operator<=(chunked_vector<T, Allocator, BlockBytes> const& lhs, chunked_vector<T, Allocator, BlockBytes> const& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+bool operator>(chunked_vector<T, Allocator, BlockBytes> const& lhs, chunked_vector<T, Allocator, BlockBytes> const& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+bool operator>=(chunked_vector<T, Allocator, BlockBytes> const& lhs, chunked_vector<T, Allocator, BlockBytes> const& rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes>
+void swap(chunked_vector<T, Allocator, BlockBytes>& lhs, chunked_vector<T, Allocator, BlockBytes>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <typename T, typename Allocator, std::size_t BlockBytes, typename Pred>
+typename chunked_vector<T, Allocator, BlockBytes>::size_type erase_if(chunked_vector<T, Allocator, BlockBytes>& c, Pred pred)
+{
+    auto itr = std::remove_if(c.begin(), c.end(), std::move(pred));
+    auto r = std::distance(itr, c.end());
+    c.erase(itr, c.end());
+    return r;
+}
+
+} // namespace flat_map
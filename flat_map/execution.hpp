@@ -0,0 +1,17 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+namespace flat_map
+{
+
+// Runs construction and bulk insertion on `threads` threads, or on std::thread::hardware_concurrency() threads if 0.
+struct parallel_policy
+{
+    unsigned threads = 0;
+};
+
+inline constexpr parallel_policy parallel{};
+
+} // namespace flat_map
@@ -18,14 +18,16 @@
 #include "flat_map/__type_traits.hpp"
 #include "flat_map/__binary_flat_tree.hpp"
 #include "flat_map/enum.hpp"
+#include "flat_map/index.hpp"
 
 namespace flat_map
 {
 
 template <typename Key, typename T,
           typename Compare = std::less<Key>,
-          typename Container = std::vector<std::pair<Key, T>>>
-class flat_map : private detail::_binary_flat_tree_base<flat_map<Key, T, Compare, Container>, Key, Compare, Container>
+          typename Container = std::vector<std::pair<Key, T>>,
+          typename Index = index::none>
+class flat_map : private detail::_binary_flat_tree_base<flat_map<Key, T, Compare, Container, Index>, Key, Compare, Container, Index>
 {
     using _super = typename flat_map::_binary_flat_tree_base;
 
@@ -51,6 +53,8 @@ public:
     using reverse_iterator       = typename _super::reverse_iterator;
     using const_reverse_iterator = typename _super::const_reverse_iterator;
     using node_type              = typename _super::node_type;
+    using cursor                 = typename _super::cursor;
+    using const_cursor           = typename _super::const_cursor;
     struct value_compare
     {
     protected:
@@ -61,7 +65,7 @@ public:
     public:
         bool operator()(const_reference lhs, const_reference rhs) const
         {
-            return c(std::get<0>(lhs), std::get<0>(rhs));
+            return detail::invoke_less(c, std::get<0>(lhs), std::get<0>(rhs));
         }
     };
     using insert_return_type = typename _super::insert_return_type;
@@ -76,13 +80,13 @@ private:
         template <typename K, typename = std::enable_if_t<!std::is_convertible_v<K, value_type>>>
         auto operator()(const_reference lhs, K const& rhs) const
         {
-            return this->c(std::get<0>(lhs), rhs);
+            return detail::invoke_less(this->c, std::get<0>(lhs), rhs);
         }
 
         template <typename K, typename = std::enable_if_t<!std::is_convertible_v<K, value_type>>>
         auto operator()(K const& lhs, const_reference rhs) const
         {
-            return this->c(lhs, std::get<0>(rhs));
+            return detail::invoke_less(this->c, lhs, std::get<0>(rhs));
         }
     };
 
@@ -112,6 +116,14 @@ public:
         this->_initialize_container(first, last);
     }
 
+    // extension
+    template <typename InputIterator>
+    flat_map(parallel_policy policy, InputIterator first, InputIterator last, Compare const& comp = Compare(), allocator_type const& alloc = allocator_type())
+      : _super{comp, alloc}
+    {
+        this->_initialize_container(policy, first, last);
+    }
+
     flat_map(flat_map const& other) = default;
     flat_map(flat_map const& other, allocator_type const& alloc)
       : _super{other, alloc} { }
@@ -150,6 +162,10 @@ public:
     explicit flat_map(range_order order, Container&& cont, allocator_type const& alloc)
       : _super{order, Container{std::move(cont), alloc}} { }
 
+    // extension
+    explicit flat_map(parallel_policy policy, range_order order, Container cont, Compare const& comp = Compare())
+      : _super{policy, order, std::move(cont), comp} { }
+
     flat_map& operator=(flat_map const& other) = default;
 
     flat_map& operator=(flat_map&& other) noexcept(std::is_nothrow_move_assignable_v<_super>)
@@ -200,6 +216,7 @@ public:
     using _super::reserve;
     using _super::capacity;
     using _super::shrink_to_fit;
+    using _super::freeze;
     using _super::clear;
 
     using _super::insert;
@@ -210,7 +227,7 @@ private:
     {
         static_assert(std::is_assignable_v<mapped_type&, M&&>);
         auto [itr, found] = this->_find(key);
-        if (!found) { itr = this->_container.emplace(itr, std::forward<K>(key), std::forward<M>(obj)); }
+        if (!found) { itr = this->_emplace_at(itr, std::forward<K>(key), std::forward<M>(obj)); }
         else { std::get<1>(*itr) = std::forward<M>(obj); }
         return {itr, !found};
     }
@@ -220,7 +237,7 @@ private:
     {
         static_assert(std::is_assignable_v<mapped_type&, M&&>);
         auto [itr, found] = this->_insert_point_uniq(hint, key);
-        if (!found) { itr = this->_container.emplace(itr, std::forward<K>(key), std::forward<M>(obj)); }
+        if (!found) { itr = this->_emplace_at(itr, std::forward<K>(key), std::forward<M>(obj)); }
         else { std::get<1>(*itr) = std::forward<M>(obj); }
         return itr;
     }
@@ -238,6 +255,48 @@ public:
     template <typename M>
     iterator insert_or_assign(const_iterator hint, key_type&& key, M&& obj) { return _insert_or_assign(hint, std::move(key), std::forward<M>(obj)); }
 
+    // extension
+    template <typename InputIterator, typename BinaryOperation>
+    void insert_or_combine(InputIterator first, InputIterator last, BinaryOperation op) { insert_or_combine(range_order::no_ordered, first, last, std::move(op)); }
+
+    // extension
+    template <typename BinaryOperation>
+    void insert_or_combine(std::initializer_list<value_type> ilist, BinaryOperation op) { insert_or_combine(ilist.begin(), ilist.end(), std::move(op)); }
+
+    // extension
+    template <typename InputIterator, typename BinaryOperation>
+    void insert_or_combine(range_order order, InputIterator first, InputIterator last, BinaryOperation op)
+    {
+        this->_merge_pending();
+        auto& c = this->_container;
+        auto const size = c.size();
+        auto mid = c.insert(c.end(), first, last);
+        if (order == range_order::no_ordered || order == range_order::uniqued)
+        {
+            this->_stable_sort(mid, c.end());
+        }
+        // Both sorts are stable, so equivalent elements line up as the existing one followed by the inserted ones in input order.
+        std::inplace_merge(c.begin(), std::next(c.begin(), static_cast<difference_type>(size)), c.end(), this->_vcomp());
+
+        auto eq = this->_veq();
+        auto result = c.begin();
+        auto const end = c.end();
+        if (result != end)
+        {
+            for (auto itr = std::next(result); itr != end; ++itr)
+            {
+                if (eq(*result, *itr)) { std::get<1>(*result) = op(std::move(std::get<1>(*result)), std::move(std::get<1>(*itr))); }
+                else if (++result != itr) { *result = std::move(*itr); }
+            }
+            c.erase(std::next(result), end);
+        }
+        this->_invalidate();
+    }
+
+    // extension
+    template <typename BinaryOperation>
+    void insert_or_combine(range_order order, std::initializer_list<value_type> ilist, BinaryOperation op) { insert_or_combine(order, ilist.begin(), ilist.end(), std::move(op)); }
+
     using _super::emplace;
     using _super::emplace_hint;
 
@@ -248,10 +307,10 @@ private:
         auto [itr, found] = this->_find(key);
         if (!found)
         {
-            itr = this->_container.emplace(itr,
-                                           std::piecewise_construct,
-                                           std::forward_as_tuple(std::forward<K>(key)),
-                                           std::forward_as_tuple(std::forward<Args>(args)...));
+            itr = this->_emplace_at(itr,
+                                    std::piecewise_construct,
+                                    std::forward_as_tuple(std::forward<K>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
         }
         return {itr, !found};
     }
@@ -262,10 +321,10 @@ private:
         auto [itr, found] = this->_insert_point_uniq(hint, key);
         if (!found)
         {
-            itr = this->_container.emplace(itr,
-                                           std::piecewise_construct,
-                                           std::forward_as_tuple(std::forward<K>(key)),
-                                           std::forward_as_tuple(std::forward<Args>(args)...));
+            itr = this->_emplace_at(itr,
+                                    std::piecewise_construct,
+                                    std::forward_as_tuple(std::forward<K>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
         }
         return itr;
     }
@@ -284,6 +343,7 @@ public:
     iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args) { return _try_emplace(hint, std::move(key), std::forward<Args>(args)...); }
 
     using _super::erase;
+    using _super::erase_keys;
 
     void swap(flat_map& other) noexcept(noexcept(this->_super::swap(other))) { _super::swap(other); }
 
@@ -302,20 +362,20 @@ public:
     void merge(std::multimap<key_type, mapped_type, Comp, Allocator>&& source) { this->_merge(source, std::true_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_map<key_type, mapped_type, Comp, Cont>& source) { this->_merge(source, std::false_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_map<key_type, mapped_type, Comp, Cont, Idx>& source) { this->_merge(source, std::false_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_map<key_type, mapped_type, Comp, Cont>&& source) { this->_merge(source, std::false_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_map<key_type, mapped_type, Comp, Cont, Idx>&& source) { this->_merge(source, std::false_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_multimap<key_type, mapped_type, Comp, Cont>& source) { this->_merge(source, std::true_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_multimap<key_type, mapped_type, Comp, Cont, Idx>& source) { this->_merge(source, std::true_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_multimap<key_type, mapped_type, Comp, Cont>&& source) { this->_merge(source, std::true_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_multimap<key_type, mapped_type, Comp, Cont, Idx>&& source) { this->_merge(source, std::true_type{}); }
 
     using _super::count;
     using _super::find;
@@ -323,63 +383,68 @@ public:
     using _super::equal_range;
     using _super::lower_bound;
     using _super::upper_bound;
+    using _super::lower_bound_many;
+    using _super::find_many;
+    using _super::contains_many;
     using _super::key_comp;
     using _super::value_comp;
+    using _super::make_cursor;
+    using _super::lookup_index;
 };
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator==(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator==(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 #ifndef FLAT_MAP_HAS_THREE_WAY_COMPARISON
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator!=(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator!=(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return !(lhs == rhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator<(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator<(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator<=(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator<=(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return !(rhs < lhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator>(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator>(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return rhs < lhs;
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator>=(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator>=(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return !(lhs < rhs);
 }
 #else
-template <typename Key, typename T, typename Compare, typename Container>
-auto operator<=>(flat_map<Key, T, Compare, Container> const& lhs, flat_map<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+auto operator<=>(flat_map<Key, T, Compare, Container, Index> const& lhs, flat_map<Key, T, Compare, Container, Index> const& rhs)
 {
     return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 #endif
 
-template <typename Key, typename T, typename Compare, typename Container>
-void swap(flat_map<Key, T, Compare, Container>& lhs, flat_map<Key, T, Compare, Container>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+void swap(flat_map<Key, T, Compare, Container, Index>& lhs, flat_map<Key, T, Compare, Container, Index>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Container, typename Pred>
-constexpr typename flat_map<Key, T, Compare, Container>::size_type
-erase_if(flat_map<Key, T, Compare, Container>& c, Pred pred)
+template <typename Key, typename T, typename Compare, typename Container, typename Index, typename Pred>
+constexpr typename flat_map<Key, T, Compare, Container, Index>::size_type
+erase_if(flat_map<Key, T, Compare, Container, Index>& c, Pred pred)
 {
     auto itr = std::remove_if(c.begin(), c.end(), std::forward<Pred>(pred));
     auto r = std::distance(itr, c.end());
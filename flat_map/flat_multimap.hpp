@@ -16,14 +16,16 @@
 #include "flat_map/__type_traits.hpp"
 #include "flat_map/__binary_flat_tree.hpp"
 #include "flat_map/enum.hpp"
+#include "flat_map/index.hpp"
 
 namespace flat_map
 {
 
 template <typename Key, typename T,
           typename Compare = std::less<Key>,
-          typename Container = std::vector<std::pair<Key, T>>>
-class flat_multimap : private detail::_binary_flat_tree_base<flat_multimap<Key, T, Compare, Container>, Key, Compare, Container>
+          typename Container = std::vector<std::pair<Key, T>>,
+          typename Index = index::none>
+class flat_multimap : private detail::_binary_flat_tree_base<flat_multimap<Key, T, Compare, Container, Index>, Key, Compare, Container, Index>
 {
     using _super = typename flat_multimap::_binary_flat_tree_base;
 
@@ -49,6 +51,8 @@ public:
     using reverse_iterator       = typename _super::reverse_iterator;
     using const_reverse_iterator = typename _super::const_reverse_iterator;
     using node_type              = typename _super::node_type;
+    using cursor                 = typename _super::cursor;
+    using const_cursor           = typename _super::const_cursor;
     struct value_compare
     {
     protected:
@@ -59,7 +63,7 @@ public:
     public:
         bool operator()(const_reference lhs, const_reference rhs) const
         {
-            return c(std::get<0>(lhs), std::get<0>(rhs));
+            return detail::invoke_less(c, std::get<0>(lhs), std::get<0>(rhs));
         }
     };
 
@@ -73,13 +77,13 @@ private:
         template <typename K, typename = std::enable_if_t<!std::is_convertible_v<K, value_type>>>
         auto operator()(const_reference lhs, K const& rhs) const
         {
-            return this->c(std::get<0>(lhs), rhs);
+            return detail::invoke_less(this->c, std::get<0>(lhs), rhs);
         }
 
         template <typename K, typename = std::enable_if_t<!std::is_convertible_v<K, value_type>>>
         auto operator()(K const& lhs, const_reference rhs) const
         {
-            return this->c(lhs, std::get<0>(rhs));
+            return detail::invoke_less(this->c, lhs, std::get<0>(rhs));
         }
     };
 
@@ -109,6 +113,14 @@ public:
         this->_initialize_container(first, last);
     }
 
+    // extension
+    template <typename InputIterator>
+    flat_multimap(parallel_policy policy, InputIterator first, InputIterator last, Compare const& comp = Compare(), allocator_type const& alloc = allocator_type())
+      : _super{comp, alloc}
+    {
+        this->_initialize_container(policy, first, last);
+    }
+
     flat_multimap(flat_multimap const& other) = default;
     flat_multimap(flat_multimap const& other, allocator_type const& alloc)
       : _super{other, alloc} { }
@@ -147,6 +159,10 @@ public:
     explicit flat_multimap(range_order order, Container&& cont, allocator_type const& alloc)
       : _super{order, Container{std::move(cont), alloc}} { }
 
+    // extension
+    explicit flat_multimap(parallel_policy policy, range_order order, Container cont, Compare const& comp = Compare())
+      : _super{policy, order, std::move(cont), comp} { }
+
     flat_multimap& operator=(flat_multimap const& other) = default;
 
     flat_multimap& operator=(flat_multimap&& other) noexcept(std::is_nothrow_move_assignable_v<_super>)
@@ -183,6 +199,7 @@ public:
     using _super::reserve;
     using _super::capacity;
     using _super::shrink_to_fit;
+    using _super::freeze;
     using _super::clear;
 
     using _super::insert;
@@ -190,6 +207,7 @@ public:
     using _super::emplace_hint;
 
     using _super::erase;
+    using _super::erase_keys;
 
     void swap(flat_multimap& other) noexcept(noexcept(this->_super::swap(other))) { _super::swap(other); }
 
@@ -208,20 +226,20 @@ public:
     void merge(std::multimap<key_type, mapped_type, Comp, Allocator>&& source) { this->_merge(source, std::true_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_map<key_type, mapped_type, Comp, Cont>& source) { this->_merge(source, std::false_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_map<key_type, mapped_type, Comp, Cont, Idx>& source) { this->_merge(source, std::false_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_map<key_type, mapped_type, Comp, Cont>&& source) { this->_merge(source, std::false_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_map<key_type, mapped_type, Comp, Cont, Idx>&& source) { this->_merge(source, std::false_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_multimap<key_type, mapped_type, Comp, Cont>& source) { this->_merge(source, std::true_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_multimap<key_type, mapped_type, Comp, Cont, Idx>& source) { this->_merge(source, std::true_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_multimap<key_type, mapped_type, Comp, Cont>&& source) { this->_merge(source, std::true_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_multimap<key_type, mapped_type, Comp, Cont, Idx>&& source) { this->_merge(source, std::true_type{}); }
 
     using _super::count;
     using _super::find;
@@ -229,63 +247,68 @@ public:
     using _super::equal_range;
     using _super::lower_bound;
     using _super::upper_bound;
+    using _super::lower_bound_many;
+    using _super::find_many;
+    using _super::contains_many;
     using _super::key_comp;
     using _super::value_comp;
+    using _super::make_cursor;
+    using _super::lookup_index;
 };
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator==(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator==(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 #ifndef FLAT_MAP_HAS_THREE_WAY_COMPARISON
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator!=(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator!=(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return !(lhs == rhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator<(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator<(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator<=(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator<=(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return !(rhs < lhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator>(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator>(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return rhs < lhs;
 }
 
-template <typename Key, typename T, typename Compare, typename Container>
-bool operator>=(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+bool operator>=(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return !(lhs < rhs);
 }
 #else
-template <typename Key, typename T, typename Compare, typename Container>
-auto operator<=>(flat_multimap<Key, T, Compare, Container> const& lhs, flat_multimap<Key, T, Compare, Container> const& rhs)
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+auto operator<=>(flat_multimap<Key, T, Compare, Container, Index> const& lhs, flat_multimap<Key, T, Compare, Container, Index> const& rhs)
 {
     return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 #endif
 
-template <typename Key, typename T, typename Compare, typename Container>
-void swap(flat_multimap<Key, T, Compare, Container>& lhs, flat_multimap<Key, T, Compare, Container>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+template <typename Key, typename T, typename Compare, typename Container, typename Index>
+void swap(flat_multimap<Key, T, Compare, Container, Index>& lhs, flat_multimap<Key, T, Compare, Container, Index>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Container, typename Pred>
-constexpr typename flat_multimap<Key, T, Compare, Container>::size_type
-erase_if(flat_multimap<Key, T, Compare, Container>& c, Pred pred)
+template <typename Key, typename T, typename Compare, typename Container, typename Index, typename Pred>
+constexpr typename flat_multimap<Key, T, Compare, Container, Index>::size_type
+erase_if(flat_multimap<Key, T, Compare, Container, Index>& c, Pred pred)
 {
     auto itr = std::remove_if(c.begin(), c.end(), std::forward<Pred>(pred));
     auto r = std::distance(itr, c.end());
@@ -16,14 +16,16 @@
 #include "flat_map/__type_traits.hpp"
 #include "flat_map/__binary_flat_tree.hpp"
 #include "flat_map/enum.hpp"
+#include "flat_map/index.hpp"
 
 namespace flat_map
 {
 
 template <typename Key,
           typename Compare = std::less<Key>,
-          typename Container = std::vector<Key>>
-class flat_set : private detail::_binary_flat_tree_base<flat_set<Key, Compare, Container>, Key, Compare, Container>
+          typename Container = std::vector<Key>,
+          typename Index = index::none>
+class flat_set : private detail::_binary_flat_tree_base<flat_set<Key, Compare, Container, Index>, Key, Compare, Container, Index>
 {
     using _super = typename flat_set::_binary_flat_tree_base;
 
@@ -49,10 +51,12 @@ public:
     using reverse_iterator       = typename _super::reverse_iterator;
     using const_reverse_iterator = typename _super::const_reverse_iterator;
     using node_type              = typename _super::node_type;
+    using cursor                 = typename _super::cursor;
+    using const_cursor           = typename _super::const_cursor;
     using insert_return_type     = typename _super::insert_return_type;
 
 private:
-    using _comparator = value_compare;
+    using _comparator = detail::less_of_t<value_compare>;
 
     template <typename V>
     static auto& _key_extractor(V const& value) { return value; }
@@ -80,6 +84,14 @@ public:
         this->_initialize_container(first, last);
     }
 
+    // extension
+    template <typename InputIterator>
+    flat_set(parallel_policy policy, InputIterator first, InputIterator last, Compare const& comp = Compare(), allocator_type const& alloc = allocator_type())
+      : _super{comp, alloc}
+    {
+        this->_initialize_container(policy, first, last);
+    }
+
     flat_set(flat_set const& other) = default;
     flat_set(flat_set const& other, allocator_type const& alloc)
       : _super{other, alloc} { }
@@ -118,6 +130,10 @@ public:
     explicit flat_set(range_order order, Container&& cont, allocator_type const& alloc)
       : _super{order, Container{std::move(cont), alloc}} { }
 
+    // extension
+    explicit flat_set(parallel_policy policy, range_order order, Container cont, Compare const& comp = Compare())
+      : _super{policy, order, std::move(cont), comp} { }
+
     flat_set& operator=(flat_set const& other) = default;
 
     flat_set& operator=(flat_set&& other) noexcept(std::is_nothrow_move_assignable_v<_super>)
@@ -154,6 +170,7 @@ public:
     using _super::reserve;
     using _super::capacity;
     using _super::shrink_to_fit;
+    using _super::freeze;
     using _super::clear;
 
     using _super::insert;
@@ -161,6 +178,7 @@ public:
     using _super::emplace_hint;
 
     using _super::erase;
+    using _super::erase_keys;
 
     void swap(flat_set& other) noexcept(noexcept(this->_super::swap(other))) { _super::swap(other); }
 
@@ -179,20 +197,20 @@ public:
     void merge(std::multiset<key_type, Comp, Allocator>&& source) { this->_merge(source, std::true_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_set<key_type, Comp, Cont>& source) { this->_merge(source, std::false_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_set<key_type, Comp, Cont, Idx>& source) { this->_merge(source, std::false_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_set<key_type, Comp, Cont>&& source) { this->_merge(source, std::false_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_set<key_type, Comp, Cont, Idx>&& source) { this->_merge(source, std::false_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_multiset<key_type, Comp, Cont>& source) { this->_merge(source, std::true_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_multiset<key_type, Comp, Cont, Idx>& source) { this->_merge(source, std::true_type{}); }
 
     // extension
-    template <typename Comp, typename Cont>
-    void merge(flat_multiset<key_type, Comp, Cont>&& source) { this->_merge(source, std::true_type{}); }
+    template <typename Comp, typename Cont, typename Idx>
+    void merge(flat_multiset<key_type, Comp, Cont, Idx>&& source) { this->_merge(source, std::true_type{}); }
 
     using _super::count;
     using _super::find;
@@ -200,63 +218,68 @@ public:
     using _super::equal_range;
     using _super::lower_bound;
     using _super::upper_bound;
+    using _super::lower_bound_many;
+    using _super::find_many;
+    using _super::contains_many;
     using _super::key_comp;
     using _super::value_comp;
+    using _super::make_cursor;
+    using _super::lookup_index;
 };
 
-template <typename Key, typename Compare, typename Container>
-bool operator==(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+bool operator==(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 #ifndef FLAT_MAP_HAS_THREE_WAY_COMPARISON
-template <typename Key, typename Compare, typename Container>
-bool operator!=(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+bool operator!=(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return !(lhs == rhs);
 }
 
-template <typename Key, typename Compare, typename Container>
-bool operator<(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+bool operator<(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Key, typename Compare, typename Container>
-bool operator<=(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+bool operator<=(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return !(rhs < lhs);
 }
 
-template <typename Key, typename Compare, typename Container>
-bool operator>(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+bool operator>(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return rhs < lhs;
 }
 
-template <typename Key, typename Compare, typename Container>
-bool operator>=(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+bool operator>=(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return !(lhs < rhs);
 }
 #else
-template <typename Key, typename Compare, typename Container>
-auto operator<=>(flat_set<Key, Compare, Container> const& lhs, flat_set<Key, Compare, Container> const& rhs)
+template <typename Key, typename Compare, typename Container, typename Index>
+auto operator<=>(flat_set<Key, Compare, Container, Index> const& lhs, flat_set<Key, Compare, Container, Index> const& rhs)
 {
     return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 #endif
 
-template <typename Key, typename Compare, typename Container>
-void swap(flat_set<Key, Compare, Container>& lhs, flat_set<Key, Compare, Container>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+template <typename Key, typename Compare, typename Container, typename Index>
+void swap(flat_set<Key, Compare, Container, Index>& lhs, flat_set<Key, Compare, Container, Index>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
-template <typename Key, typename Compare, typename Container, typename Pred>
-constexpr typename flat_set<Key, Compare, Container>::size_type
-erase_if(flat_set<Key, Compare, Container>& c, Pred pred)
+template <typename Key, typename Compare, typename Container, typename Index, typename Pred>
+constexpr typename flat_set<Key, Compare, Container, Index>::size_type
+erase_if(flat_set<Key, Compare, Container, Index>& c, Pred pred)
 {
     auto itr = std::remove_if(c.begin(), c.end(), std::forward<Pred>(pred));
     auto r = std::distance(itr, c.end());
@@ -0,0 +1,902 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flat_map/__algorithm.hpp"
+#include "flat_map/__memory.hpp"
+
+namespace flat_map::index
+{
+
+// Lookup by binary search over the underlying container, no auxiliary data.
+struct none
+{
+    template <typename Key, typename Compare>
+    struct store { };
+};
+
+// Lookup by Eytzinger (BFS ordered) copy of the keys.
+// The copy is (re)built at the first lookup after modification.
+struct eytzinger
+{
+    template <typename Key, typename Compare>
+    class store
+    {
+        static constexpr std::size_t _block = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+        // 1-origin full binary tree, padded with the greatest key.
+        std::vector<Key> _tree;
+        std::size_t _size = 0;
+        std::size_t _height = 0;
+        bool _valid = false;
+
+        std::size_t _rank(std::size_t k) const noexcept
+        {
+            auto const depth = 63 - __builtin_clzll(k);
+            return ((2 * (k - (std::size_t{1} << depth)) + 1) << (_height - 1 - depth)) - 1;
+        }
+
+    public:
+        store() = default;
+        store(store const&) = default;
+        store(store&& other) noexcept
+          : _tree{std::move(other._tree)}, _size{other._size}, _height{other._height}, _valid{std::exchange(other._valid, false)} { }
+
+        store& operator=(store const&) = default;
+        store& operator=(store&& other) noexcept
+        {
+            _tree = std::move(other._tree);
+            _size = other._size;
+            _height = other._height;
+            _valid = std::exchange(other._valid, false);
+            return *this;
+        }
+
+        void invalidate() noexcept { _valid = false; }
+
+        template <typename Keys>
+        void build(Keys const& keys)
+        {
+            _tree.clear();
+            _size = keys.size();
+            _height = 0;
+            if (_size != 0)
+            {
+                _height = 64 - __builtin_clzll(_size);
+                auto const n = (std::size_t{1} << _height);
+                _tree.reserve(n);
+                _tree.push_back(keys[0]);
+                for (std::size_t k = 1; k < n; ++k) { _tree.push_back(keys[std::min(_rank(k), _size - 1)]); }
+            }
+            _valid = true;
+        }
+
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            if (!_valid) { build(keys); }
+            if (_size == 0) { return {0, 0}; }
+
+            auto const n = _tree.size();
+            std::size_t k = 1;
+            while (k < n)
+            {
+                detail::prefetch(_tree.data() + std::min(k * _block, n - 1));
+                k = 2 * k + static_cast<std::size_t>(pred(_tree[k]));
+            }
+            k >>= __builtin_ctzll(~k) + 1;
+
+            auto const pos = k == 0 ? _size : std::min(_rank(k), _size);
+            return {pos, pos};
+        }
+    };
+};
+
+// Lookup by static B+-tree of separator keys, whose node fits in a cache line.
+// The tree is (re)built at the first lookup after modification, or by freeze().
+struct static_btree
+{
+    template <typename Key, typename Compare>
+    class store
+    {
+        static constexpr std::size_t _fanout = sizeof(Key) < 32 ? 64 / sizeof(Key) : 2;
+
+        struct alignas(64) node { Key keys[_fanout]; };
+
+        // Layers from the bottom, each separator is the greatest key of a block in the lower layer.
+        // The bottom layer separates blocks of the underlying container, and every layer is padded with the greatest key.
+        std::vector<node> _nodes;
+        std::vector<std::pair<std::size_t, std::size_t>> _layers;
+        std::size_t _size = 0;
+        bool _valid = false;
+
+    public:
+        store() = default;
+        store(store const&) = default;
+        store(store&& other) noexcept
+          : _nodes{std::move(other._nodes)}, _layers{std::move(other._layers)}, _size{other._size}, _valid{std::exchange(other._valid, false)} { }
+
+        store& operator=(store const&) = default;
+        store& operator=(store&& other) noexcept
+        {
+            _nodes = std::move(other._nodes);
+            _layers = std::move(other._layers);
+            _size = other._size;
+            _valid = std::exchange(other._valid, false);
+            return *this;
+        }
+
+        void invalidate() noexcept { _valid = false; }
+
+        template <typename Keys>
+        void build(Keys const& keys)
+        {
+            _nodes.clear();
+            _layers.clear();
+            _size = keys.size();
+            if (_size != 0)
+            {
+                auto nodes = (_size + _fanout * _fanout - 1) / (_fanout * _fanout);
+                _nodes.resize(nodes);
+                for (std::size_t i = 0; i < nodes * _fanout; ++i)
+                {
+                    _nodes[i / _fanout].keys[i % _fanout] = keys[std::min(i * _fanout + _fanout - 1, _size - 1)];
+                }
+                _layers.emplace_back(0, nodes);
+
+                while (nodes > 1)
+                {
+                    auto const lower = _layers.back().first;
+                    auto const count = nodes;
+                    auto const offset = _nodes.size();
+                    nodes = (count + _fanout - 1) / _fanout;
+                    _nodes.resize(offset + nodes);
+                    for (std::size_t i = 0; i < nodes * _fanout; ++i)
+                    {
+                        _nodes[offset + i / _fanout].keys[i % _fanout] = _nodes[lower + std::min(i, count - 1)].keys[_fanout - 1];
+                    }
+                    _layers.emplace_back(offset, nodes);
+                }
+            }
+            _valid = true;
+        }
+
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            if (!_valid) { build(keys); }
+
+            std::size_t c = 0;
+            for (auto l = _layers.size(); l-- > 0; )
+            {
+                auto const [offset, nodes] = _layers[l];
+                if (c >= nodes) { return {_size, _size}; }
+                c = c * _fanout + detail::count_bound(_nodes[offset + c].keys, _fanout, pred);
+            }
+
+            // The greatest key of the block doesn't satisfy pred.
+            auto const lo = c * _fanout;
+            if (lo >= _size) { return {_size, _size}; }
+            return {lo, std::min(lo + _fanout - 1, _size - 1)};
+        }
+    };
+};
+
+// Lookup by piecewise linear model from keys to positions, whose error is at most Epsilon.
+// The model is (re)built at the first lookup after modification, or by freeze().
+// Other keys and orders than arithmetic ones by std::less are looked up as same as none.
+template <std::size_t Epsilon = 32>
+struct learned
+{
+    template <typename Key, typename Compare>
+    class model_store
+    {
+        struct segment
+        {
+            Key key;
+            std::size_t pos;
+            double slope;
+        };
+
+        std::vector<segment> _segments;
+        std::size_t _size = 0;
+        bool _valid = false;
+
+        std::size_t _predict(Key const& key) const noexcept
+        {
+            auto const seg = std::upper_bound(_segments.begin(), _segments.end(), key, [](Key const& lhs, segment const& rhs) { return lhs < rhs.key; });
+            if (seg == _segments.begin()) { return 0; }
+
+            auto const& [first, offset, slope] = *std::prev(seg);
+            auto const predicted = static_cast<double>(offset) + slope * detail::key_distance(first, key);
+            return predicted < static_cast<double>(_size) ? static_cast<std::size_t>(predicted) : _size;
+        }
+
+    public:
+        model_store() = default;
+        model_store(model_store const&) = default;
+        model_store(model_store&& other) noexcept
+          : _segments{std::move(other._segments)}, _size{other._size}, _valid{std::exchange(other._valid, false)} { }
+
+        model_store& operator=(model_store const&) = default;
+        model_store& operator=(model_store&& other) noexcept
+        {
+            _segments = std::move(other._segments);
+            _size = other._size;
+            _valid = std::exchange(other._valid, false);
+            return *this;
+        }
+
+        void invalidate() noexcept { _valid = false; }
+
+        // Greedy shrinking cone over the first position of each distinct key.
+        template <typename Keys>
+        void build(Keys const& keys)
+        {
+            constexpr auto eps = static_cast<double>(Epsilon);
+
+            _segments.clear();
+            _size = keys.size();
+            for (std::size_t i = 0; i < _size; )
+            {
+                Key const first = keys[i];
+                auto lo = 0.0;
+                auto hi = std::numeric_limits<double>::infinity();
+
+                auto j = i + 1;
+                for (; j < _size; ++j)
+                {
+                    if (!(keys[j - 1] < keys[j])) { continue; }
+
+                    auto const dx = detail::key_distance(first, keys[j]);
+                    auto const dy = static_cast<double>(j - i);
+                    auto const next_lo = std::max(lo, (dy - eps) / dx);
+                    auto const next_hi = std::min(hi, (dy + eps) / dx);
+                    if (next_lo > next_hi) { break; }
+                    lo = next_lo;
+                    hi = next_hi;
+                }
+                _segments.push_back({first, i, hi == std::numeric_limits<double>::infinity() ? 0.0 : (lo + hi) / 2});
+                i = j;
+            }
+            _valid = true;
+        }
+
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            if (!_valid) { build(keys); }
+            if (_size == 0) { return {0, 0}; }
+            // heterogeneous lookup by std::less<>
+            if constexpr (!std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(pred.key)>>, Key>) { return {0, _size}; }
+            else
+            {
+                auto const pos = _predict(pred.key);
+
+                // The model is just a hint: widen the window until it surely contains the partition point.
+                std::size_t lo = pos > Epsilon + 1 ? pos - Epsilon - 1 : 0;
+                std::size_t hi = std::min(pos + Epsilon + 1, _size);
+                for (std::size_t step = Epsilon + 1; lo > 0 && !pred(keys[lo - 1]); step *= 2)
+                {
+                    hi = lo - 1;
+                    lo = lo > step ? lo - step : 0;
+                }
+                for (std::size_t step = Epsilon + 1; hi < _size && pred(keys[hi]); step *= 2)
+                {
+                    lo = hi + 1;
+                    hi = std::min(hi + step, _size);
+                }
+                return {lo, hi};
+            }
+        }
+    };
+
+    template <typename Key, typename Compare>
+    using store = std::conditional_t<std::is_arithmetic_v<Key> && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>),
+                                     model_store<Key, Compare>,
+                                     none::store<Key, Compare>>;
+};
+
+// Lookup by interpolation search, which probes where the key would be if keys were uniformly distributed.
+// The search is guarded by Steps probes, and the rest is left to the binary search.
+// Other keys and orders than arithmetic ones by std::less or std::greater are looked up as same as none.
+template <std::size_t Steps = 8>
+struct interpolation
+{
+    template <typename Key, typename Compare>
+    struct interpolation_store
+    {
+        static constexpr std::size_t _window = 16;
+        static constexpr std::size_t _guard = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+        // No auxiliary data to be built or invalidated.
+        void invalidate() noexcept { }
+
+        template <typename Keys>
+        void build(Keys const&) noexcept { }
+
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            auto const size = keys.size();
+            if (size == 0) { return {0, 0}; }
+            // heterogeneous lookup by std::less<> or std::greater<>
+            if constexpr (!std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(pred.key)>>, Key>) { return {0, size}; }
+            else
+            {
+                Key first = keys[0];
+                Key last = keys[size - 1];
+                if (!pred(first)) { return {0, 0}; }
+                if (pred(last)) { return {size, size}; }
+
+                // keys[lo - 1] (== first) satisfies pred and keys[hi] (== last) doesn't, so first < key <= last in order.
+                constexpr bool greater = std::is_same_v<Compare, std::greater<Key>> || std::is_same_v<Compare, std::greater<>>;
+                std::size_t lo = 1;
+                std::size_t hi = size - 1;
+                for (std::size_t step = 0; step < Steps && hi - lo > _window; ++step)
+                {
+                    auto const ratio = greater ? detail::key_distance(pred.key, first) / detail::key_distance(last, first)
+                                               : detail::key_distance(first, pred.key) / detail::key_distance(first, last);
+                    // NaN by infinite keys probes at lo
+                    auto const offset = ratio > 0 ? static_cast<std::size_t>(std::min(ratio, 1.0) * static_cast<double>(hi - lo + 1)) : 0;
+                    auto const mid = std::clamp(lo - 1 + offset, lo, hi - 1);
+
+                    // A probe next to the key shrinks the range a little, so look ahead a cache line toward the key as well.
+                    Key const x = keys[mid];
+                    auto guard = mid;
+                    if (pred(x))
+                    {
+                        lo = mid + 1;
+                        first = x;
+                        if (mid + _guard < hi) { guard = mid + _guard; }
+                    }
+                    else
+                    {
+                        hi = mid;
+                        last = x;
+                        if (lo + _guard <= mid) { guard = mid - _guard; }
+                    }
+
+                    if (guard != mid)
+                    {
+                        Key const y = keys[guard];
+                        if (pred(y))
+                        {
+                            lo = guard + 1;
+                            first = y;
+                        }
+                        else
+                        {
+                            hi = guard;
+                            last = y;
+                        }
+                    }
+                }
+                return {lo, hi};
+            }
+        }
+    };
+
+    template <typename Key, typename Compare>
+    using store = std::conditional_t<std::is_arithmetic_v<Key> && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>> ||
+                                                                   std::is_same_v<Compare, std::greater<Key>> || std::is_same_v<Compare, std::greater<>>),
+                                     interpolation_store<Key, Compare>,
+                                     none::store<Key, Compare>>;
+};
+
+// Memoization of the positions found by recent lookups, in a direct-mapped cache of Slots entries keyed by std::hash<Key>.
+// A cached position is taken only if its neighbouring keys confirm it, and every modification drops the whole cache by advancing the epoch.
+// Keys without std::hash are looked up as same as none, and so is heterogeneous lookup.
+template <std::size_t Slots = 1024>
+struct memoized
+{
+    static_assert(Slots != 0 && (Slots & (Slots - 1)) == 0, "Slots should be a power of 2");
+
+    template <typename Key, typename Compare>
+    class cache_store
+    {
+        struct slot
+        {
+            std::size_t epoch;
+            std::size_t pos;
+        };
+
+        // Allocated at the first lookup; epoch 0 never matches.
+        std::vector<slot> _slots;
+        std::size_t _epoch = 1;
+        std::size_t _pending = Slots;
+        std::size_t _hits = 0;
+        std::size_t _misses = 0;
+
+        template <typename K, typename C, bool Upper>
+        static constexpr bool _upper(detail::bound_predicate<K, C, Upper> const&) noexcept { return Upper; }
+
+        // Lower and upper bounds of a key are cached in adjacent slots.
+        static std::size_t _slot_of(Key const& key, bool upper) noexcept
+        {
+            auto const h = static_cast<std::uint64_t>(std::hash<Key>{}(key)) * 0x9e3779b97f4a7c15ull;
+            return (static_cast<std::size_t>(h >> 32) ^ static_cast<std::size_t>(upper)) & (Slots - 1);
+        }
+
+    public:
+        cache_store() = default;
+        cache_store(cache_store const&) = default;
+        cache_store(cache_store&& other) noexcept
+          : _slots{std::exchange(other._slots, {})}, _epoch{other._epoch}, _pending{std::exchange(other._pending, Slots)}, _hits{other._hits}, _misses{other._misses} { }
+
+        cache_store& operator=(cache_store const&) = default;
+        cache_store& operator=(cache_store&& other) noexcept
+        {
+            _slots = std::exchange(other._slots, {});
+            _epoch = other._epoch;
+            _pending = std::exchange(other._pending, Slots);
+            _hits = other._hits;
+            _misses = other._misses;
+            return *this;
+        }
+
+        void invalidate() noexcept
+        {
+            ++_epoch;
+            _pending = Slots;
+        }
+
+        // Filled by lookups, nothing to be built in advance.
+        template <typename Keys>
+        void build(Keys const&) noexcept { }
+
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            auto const size = keys.size();
+            _pending = Slots;
+            // heterogeneous lookup
+            if constexpr (!std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(pred.key)>>, Key>) { return {0, size}; }
+            else
+            {
+                if (_slots.empty()) { _slots.resize(Slots); }
+
+                auto const i = _slot_of(pred.key, _upper(pred));
+                auto const [epoch, pos] = _slots[i];
+                if (epoch == _epoch && pos <= size && (pos == 0 || pred(keys[pos - 1])) && (pos == size || !pred(keys[pos])))
+                {
+                    ++_hits;
+                    return {pos, pos};
+                }
+                ++_misses;
+                _pending = i;
+                return {0, size};
+            }
+        }
+
+        // Records the position found for the last missed lookup.
+        void memoize(std::size_t pos) noexcept
+        {
+            if (_pending != Slots) { _slots[std::exchange(_pending, Slots)] = {_epoch, pos}; }
+        }
+
+        std::size_t hits() const noexcept { return _hits; }
+        std::size_t misses() const noexcept { return _misses; }
+    };
+
+    template <typename Key, typename Compare>
+    using store = std::conditional_t<std::is_default_constructible_v<std::hash<Key>>,
+                                     cache_store<Key, Compare>,
+                                     none::store<Key, Compare>>;
+};
+
+// Split block Bloom filter of the keys, which rejects most of absent keys by a cache line before searching.
+// Each block is 8 words, and a key sets a bit in every word of the block selected by its hash.
+// The filter is (re)built at the first lookup after modification, or by freeze(); inserted keys are added to it and erased keys are left.
+// Keys without std::hash are looked up as same as none, and so is heterogeneous lookup.
+template <std::size_t BitsPerKey = 10>
+struct bloom
+{
+    static_assert(BitsPerKey != 0, "BitsPerKey should be positive");
+
+    template <typename Key, typename Compare>
+    class filter_store
+    {
+        struct alignas(32) block { std::uint32_t words[8]; };
+
+        static constexpr std::uint32_t _salt[8] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+        static constexpr std::size_t _block_bits = sizeof(block) * 8;
+
+        std::vector<block> _blocks;
+        std::size_t _size = 0;
+        bool _valid = false;
+
+        std::size_t _block_of(std::uint64_t h) const noexcept { return static_cast<std::size_t>(((h >> 32) * _blocks.size()) >> 32); }
+
+        static std::uint32_t _bit(std::uint64_t h, std::size_t i) noexcept { return std::uint32_t{1} << ((static_cast<std::uint32_t>(h) * _salt[i]) >> 27); }
+
+        void _add(Key const& key)
+        {
+            auto const h = detail::mixed_hash(key);
+            auto& b = _blocks[_block_of(h)];
+            for (std::size_t i = 0; i < 8; ++i) { b.words[i] |= _bit(h, i); }
+        }
+
+    public:
+        filter_store() = default;
+        filter_store(filter_store const&) = default;
+        filter_store(filter_store&& other) noexcept
+          : _blocks{std::move(other._blocks)}, _size{other._size}, _valid{std::exchange(other._valid, false)} { }
+
+        filter_store& operator=(filter_store const&) = default;
+        filter_store& operator=(filter_store&& other) noexcept
+        {
+            _blocks = std::move(other._blocks);
+            _size = other._size;
+            _valid = std::exchange(other._valid, false);
+            return *this;
+        }
+
+        void invalidate() noexcept { _valid = false; }
+
+        template <typename Keys>
+        void build(Keys const& keys)
+        {
+            _size = keys.size();
+            _blocks.assign(std::max<std::size_t>((_size * BitsPerKey + _block_bits - 1) / _block_bits, 1), block{});
+            for (std::size_t i = 0; i < _size; ++i) { _add(keys[i]); }
+            _valid = true;
+        }
+
+        // The filter doesn't narrow the range; absent keys are rejected by may_contain.
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const&) noexcept { return {0, keys.size()}; }
+
+        // Rebuilt at the next lookup after the keys doubled, not to degrade the false positive rate, or if the key can't be hashed.
+        void add(Key const& key) noexcept
+        {
+            if (!_valid) { return; }
+            if (++_size * BitsPerKey > _blocks.size() * _block_bits * 2) { _valid = false; return; }
+            try { _add(key); }
+            catch (...) { _valid = false; }
+        }
+
+        template <typename Keys, typename K>
+        bool may_contain(Keys const& keys, K const& key)
+        {
+            // heterogeneous lookup
+            if constexpr (!std::is_same_v<K, Key>) { return true; }
+            else
+            {
+                if (!_valid) { build(keys); }
+
+                auto const h = detail::mixed_hash(key);
+                auto const& b = _blocks[_block_of(h)];
+                std::uint32_t missing = 0;
+                for (std::size_t i = 0; i < 8; ++i) { missing |= ~b.words[i] & _bit(h, i); }
+                return missing == 0;
+            }
+        }
+
+        std::size_t memory_usage() const noexcept { return _blocks.size() * sizeof(block); }
+
+        // Estimated from the number of keys, assuming they are distinct and uniformly hashed.
+        double false_positive_rate() const noexcept
+        {
+            if (_blocks.empty()) { return 0.0; }
+            auto const per_block = static_cast<double>(_size) / static_cast<double>(_blocks.size());
+            return std::pow(1.0 - std::pow(1.0 - 1.0 / 32, per_block), 8);
+        }
+    };
+
+    template <typename Key, typename Compare>
+    using store = std::conditional_t<std::is_default_constructible_v<std::hash<Key>>,
+                                     filter_store<Key, Compare>,
+                                     none::store<Key, Compare>>;
+};
+
+// Open addressing hash table from keys to their first positions, for point lookups in O(1) besides ordered ones.
+// The table is (re)built at the first lookup after modification, or by freeze(); single element insertion and erasure patch the positions instead.
+// Keys without std::hash are looked up as same as none, and so is heterogeneous lookup.
+struct hashed
+{
+    template <typename Key, typename Compare>
+    class table_store
+    {
+        static constexpr std::size_t _empty = std::numeric_limits<std::size_t>::max();
+
+        struct slot
+        {
+            std::uint64_t hash;
+            std::size_t pos;
+        };
+
+        // Linear probing at load factor at most 1/2, keyed by the hash value rather than the key.
+        std::vector<slot> _slots;
+        std::size_t _entries = 0;
+        bool _valid = false;
+
+        slot& _probe(std::uint64_t h) noexcept
+        {
+            auto const mask = _slots.size() - 1;
+            auto i = static_cast<std::size_t>(h) & mask;
+            while (_slots[i].pos != _empty && _slots[i].hash != h) { i = (i + 1) & mask; }
+            return _slots[i];
+        }
+
+    public:
+        table_store() = default;
+        table_store(table_store const&) = default;
+        table_store(table_store&& other) noexcept
+          : _slots{std::move(other._slots)}, _entries{other._entries}, _valid{std::exchange(other._valid, false)} { }
+
+        table_store& operator=(table_store const&) = default;
+        table_store& operator=(table_store&& other) noexcept
+        {
+            _slots = std::move(other._slots);
+            _entries = other._entries;
+            _valid = std::exchange(other._valid, false);
+            return *this;
+        }
+
+        void invalidate() noexcept { _valid = false; }
+
+        // Equivalent keys are adjacent and have the same hash value, so that only the first one is stored.
+        template <typename Keys>
+        void build(Keys const& keys)
+        {
+            auto const size = keys.size();
+            std::size_t capacity = 16;
+            while (capacity < size * 2) { capacity *= 2; }
+            _slots.assign(capacity, slot{0, _empty});
+            _entries = 0;
+
+            std::uint64_t prev = 0;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                auto const h = detail::mixed_hash(keys[i]);
+                if (i != 0 && h == prev) { continue; }
+                prev = h;
+
+                auto& s = _probe(h);
+                if (s.pos == _empty)
+                {
+                    s = {h, i};
+                    ++_entries;
+                }
+            }
+            _valid = true;
+        }
+
+        // A stored position is taken only if its neighbouring keys confirm it, since hash values might collide.
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            if (!_valid) { build(keys); }
+            auto const size = keys.size();
+            // heterogeneous lookup
+            if constexpr (!std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(pred.key)>>, Key>) { return {0, size}; }
+            else
+            {
+                auto const pos = _probe(detail::mixed_hash(pred.key)).pos;
+                if (pos > size || (pos != 0 && !pred(keys[pos - 1]))) { return {0, size}; }
+                if (pos == size || !pred(keys[pos])) { return {pos, pos}; }
+                return {pos, size};
+            }
+        }
+
+        template <typename Keys, typename K>
+        bool may_contain(Keys const& keys, K const& key)
+        {
+            // heterogeneous lookup
+            if constexpr (!std::is_same_v<K, Key>) { return true; }
+            else
+            {
+                if (!_valid) { build(keys); }
+                return _probe(detail::mixed_hash(key)).pos != _empty;
+            }
+        }
+
+        // Positions are shifted over the whole table, as well as the elements of the container.
+        // The table is dropped if the key can't be hashed, since the element is already inserted.
+        void inserted(Key const& key, std::size_t pos) noexcept
+        {
+            if (!_valid) { return; }
+            std::uint64_t h;
+            try { h = detail::mixed_hash(key); }
+            catch (...) { _valid = false; return; }
+            for (auto& s : _slots) { s.pos += static_cast<std::size_t>(s.pos != _empty && s.pos >= pos); }
+
+            auto& s = _probe(h);
+            if (s.pos == _empty)
+            {
+                if (++_entries * 2 > _slots.size()) { _valid = false; }
+                else { s = {h, pos}; }
+            }
+            else if (s.pos > pos)
+            {
+                s.pos = pos;
+            }
+        }
+
+        // Erased keys are left at the position where they would be, so that they still give their lower bound.
+        void erased(std::size_t pos, std::size_t count) noexcept
+        {
+            if (!_valid) { return; }
+            for (auto& s : _slots)
+            {
+                if (s.pos == _empty || s.pos < pos) { continue; }
+                s.pos = s.pos >= pos + count ? s.pos - count : pos;
+            }
+        }
+
+        std::size_t memory_usage() const noexcept { return _slots.size() * sizeof(slot); }
+    };
+
+    template <typename Key, typename Compare>
+    using store = std::conditional_t<std::is_default_constructible_v<std::hash<Key>>,
+                                     table_store<Key, Compare>,
+                                     none::store<Key, Compare>>;
+};
+
+// Column of 8 bytes prefixes of string keys beside the elements, which are compared instead of the strings.
+// Since keys such as URLs and paths share a long head, the prefixes are taken after the common prefix of all keys.
+// The column is (re)built at the first lookup after modification, or by freeze(); single element insertion and erasure update it instead.
+// Keys other than strings of char ordered by std::less<Key> (or std::less<>) are looked up as same as none.
+struct prefix
+{
+    template <typename Key, typename Compare>
+    class prefix_store
+    {
+        std::vector<std::uint64_t> _prefixes;
+        std::string _head;
+        bool _valid = false;
+
+        template <bool Upper>
+        static std::size_t _partition_point(std::uint64_t const* first, std::size_t n, std::uint64_t p) noexcept
+        {
+            std::less<std::uint64_t> const comp;
+            if constexpr (detail::is_simd_searchable_v<std::uint64_t, std::less<std::uint64_t>>) { return detail::simd_partition_point<Upper>(first, n, p, comp); }
+            else { return detail::branchless_partition_point(first, n, [](auto const& x) -> auto& { return x; }, detail::bound_predicate<std::uint64_t, std::less<std::uint64_t>, Upper>{p, comp}); }
+        }
+
+    public:
+        prefix_store() = default;
+        prefix_store(prefix_store const&) = default;
+        prefix_store(prefix_store&& other) noexcept
+          : _prefixes{std::move(other._prefixes)}, _head{std::move(other._head)}, _valid{std::exchange(other._valid, false)} { }
+
+        prefix_store& operator=(prefix_store const&) = default;
+        prefix_store& operator=(prefix_store&& other) noexcept
+        {
+            _prefixes = std::move(other._prefixes);
+            _head = std::move(other._head);
+            _valid = std::exchange(other._valid, false);
+            return *this;
+        }
+
+        void invalidate() noexcept { _valid = false; }
+
+        template <typename Keys>
+        void build(Keys const& keys)
+        {
+            auto const size = keys.size();
+            _prefixes.resize(size);
+            _head.clear();
+            if (size != 0)
+            {
+                // Keys are sorted, so the common prefix of all is that of the first and the last.
+                std::string_view const first = keys[0];
+                std::string_view const last = keys[size - 1];
+                auto const n = static_cast<std::size_t>(std::mismatch(first.begin(), first.begin() + std::min(first.size(), last.size()), last.begin()).first - first.begin());
+                _head.assign(first.substr(0, n));
+            }
+            for (std::size_t i = 0; i < size; ++i) { _prefixes[i] = detail::string_prefix(std::string_view{keys[i]}.substr(_head.size())); }
+            _valid = true;
+        }
+
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const& pred)
+        {
+            if (!_valid) { build(keys); }
+            auto const size = keys.size();
+            if constexpr (!std::is_convertible_v<decltype(pred.key), std::string_view>) { return {0, size}; }
+            else
+            {
+                if (size == 0) { return {0, 0}; }
+
+                // A key differs from the head is ordered before or after all.
+                std::string_view const key = pred.key;
+                auto const n = std::min(key.size(), _head.size());
+                if (auto const c = key.substr(0, n).compare(std::string_view{_head}.substr(0, n)); c != 0) { return c < 0 ? std::pair{std::size_t{0}, std::size_t{0}} : std::pair{size, size}; }
+                if (key.size() < _head.size()) { return {0, 0}; }
+
+                // The partition point is among the keys whose prefix is equal, which are compared as strings.
+                auto const p = detail::string_prefix(key.substr(_head.size()));
+                auto const lo = _partition_point<false>(_prefixes.data(), size, p);
+                auto const hi = lo + _partition_point<true>(_prefixes.data() + lo, size - lo, p);
+                return {lo, hi};
+            }
+        }
+
+        // A key differs from the head makes the head shorter, then the column is rebuilt.
+        // The column is also dropped if it can't grow, since the element is already inserted.
+        void inserted(Key const& key, std::size_t pos) noexcept
+        {
+            if (!_valid) { return; }
+
+            std::string_view const k = key;
+            if (k.substr(0, _head.size()) != _head) { _valid = false; return; }
+            try { _prefixes.insert(_prefixes.begin() + static_cast<std::ptrdiff_t>(pos), detail::string_prefix(k.substr(_head.size()))); }
+            catch (...) { _valid = false; }
+        }
+
+        void erased(std::size_t pos, std::size_t count) noexcept
+        {
+            if (!_valid) { return; }
+            _prefixes.erase(_prefixes.begin() + static_cast<std::ptrdiff_t>(pos), _prefixes.begin() + static_cast<std::ptrdiff_t>(pos + count));
+        }
+
+        std::size_t memory_usage() const noexcept { return _prefixes.capacity() * sizeof(std::uint64_t) + _head.capacity(); }
+    };
+
+    template <typename Key, typename Compare>
+    using store = std::conditional_t<detail::is_byte_string<Key>::value && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>),
+                                     prefix_store<Key, Compare>,
+                                     none::store<Key, Compare>>;
+};
+
+// Insertion buffer at the back of the container, which keeps the elements inserted by ranges in sorted order apart from the rest.
+// Lookup searches both of them, and the buffer is merged by std::inplace_merge when it reaches Threshold elements (or sqrt(size()) if 0).
+// Member functions returning a position (insertion, find, iteration, lower_bound, ...) merge the buffer, so that no iterator points into it.
+template <std::size_t Threshold = 0>
+struct delta
+{
+    template <typename Key, typename Compare>
+    class store
+    {
+        std::size_t _pending = 0;
+
+    public:
+        store() = default;
+        store(store const&) = default;
+        store(store&& other) noexcept : _pending{std::exchange(other._pending, 0)} { }
+
+        store& operator=(store const&) = default;
+        store& operator=(store&& other) noexcept
+        {
+            _pending = std::exchange(other._pending, 0);
+            return *this;
+        }
+
+        // Called when the whole container is sorted.
+        void invalidate() noexcept { _pending = 0; }
+
+        template <typename Keys>
+        void build(Keys const&) noexcept { }
+
+        // The sorted range excludes the buffer.
+        template <typename Keys, typename Pred>
+        std::pair<std::size_t, std::size_t> narrow(Keys const& keys, Pred const&) const noexcept { return {0, keys.size() - _pending}; }
+
+        std::size_t pending() const noexcept { return _pending; }
+        void push(std::size_t n) noexcept { _pending += n; }
+        void drop(std::size_t n) noexcept { _pending -= n; }
+
+        bool full(std::size_t size) const noexcept
+        {
+            if constexpr (Threshold != 0) { return _pending >= Threshold; }
+            else { return _pending >= 16 && _pending * _pending >= size; }
+        }
+    };
+};
+
+} // namespace flat_map::index
@@ -0,0 +1,603 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flat_map/__config.hpp"
+#include "flat_map/__fenwick_tree.hpp"
+
+namespace flat_map
+{
+
+// Sequence whose elements are spread over fixed size segments with gaps, so that insertion and erasure shift only a segment.
+// A full segment is rebalanced with its neighbours in the smallest enclosing window of 2^h segments within density threshold.
+template <typename T, typename Allocator = std::allocator<T>>
+class packed_memory_array
+{
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = value_type const&;
+    using pointer                = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+
+private:
+    template <bool Const>
+    class _iterator
+    {
+        friend class packed_memory_array;
+
+        template <bool>
+        friend class _iterator;
+
+        using container_type = std::conditional_t<Const, packed_memory_array const, packed_memory_array>;
+
+        container_type* _c = nullptr;
+        size_type _slot = 0;
+
+        _iterator(container_type* c, size_type slot) noexcept : _c{c}, _slot{slot} { }
+
+    public:
+        using difference_type   = packed_memory_array::difference_type;
+        using value_type        = packed_memory_array::value_type;
+        using pointer           = std::conditional_t<Const, value_type const*, value_type*>;
+        using reference         = std::conditional_t<Const, value_type const&, value_type&>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        _iterator() = default;
+
+        template <bool C, typename = std::enable_if_t<Const && !C>>
+        _iterator(_iterator<C> const& other) noexcept : _c{other._c}, _slot{other._slot} { }
+
+        reference operator*() const { return _c->_slots[_slot]; }
+        pointer operator->() const { return std::addressof(_c->_slots[_slot]); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        _iterator& operator++()
+        {
+            _slot = _c->_next_slot(_slot);
+            return *this;
+        }
+
+        _iterator operator++(int)
+        {
+            auto copy = *this;
+            operator++();
+            return copy;
+        }
+
+        _iterator& operator--()
+        {
+            _slot = _c->_prev_slot(_slot);
+            return *this;
+        }
+
+        _iterator operator--(int)
+        {
+            auto copy = *this;
+            operator--();
+            return copy;
+        }
+
+        _iterator& operator+=(difference_type n)
+        {
+            _slot = _c->_advance(_slot, n);
+            return *this;
+        }
+
+        _iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend _iterator operator+(_iterator itr, difference_type n) { return itr += n; }
+        friend _iterator operator+(difference_type n, _iterator itr) { return itr += n; }
+        friend _iterator operator-(_iterator itr, difference_type n) { return itr -= n; }
+
+        template <bool C>
+        difference_type operator-(_iterator<C> const& other) const { return _c->_distance(other._slot, _slot); }
+
+        // Slots are ordered as same as the elements.
+        template <bool C> bool operator==(_iterator<C> const& other) const noexcept { return _c == other._c && _slot == other._slot; }
+        template <bool C> bool operator!=(_iterator<C> const& other) const noexcept { return !(*this == other); }
+        template <bool C> bool operator<(_iterator<C> const& other) const noexcept { return _slot < other._slot; }
+        template <bool C> bool operator>(_iterator<C> const& other) const noexcept { return _slot > other._slot; }
+        template <bool C> bool operator<=(_iterator<C> const& other) const noexcept { return _slot <= other._slot; }
+        template <bool C> bool operator>=(_iterator<C> const& other) const noexcept { return _slot >= other._slot; }
+    };
+
+public:
+    using iterator               = _iterator<false>;
+    using const_iterator         = _iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using _size_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
+
+    static constexpr size_type _min_capacity = 16;
+
+    // Gaps hold default constructed or moved-from values.
+    std::vector<T, Allocator> _slots;
+    // Number of elements in each segment, those are packed at the front of the segment.
+    std::vector<size_type, _size_allocator> _count;
+    // Translates between positions and slots.
+    detail::fenwick_tree<_size_allocator> _tree;
+    size_type _size = 0;
+    size_type _shift = 0;
+
+    static size_type _log2(size_type n) noexcept
+    {
+        size_type r = 0;
+        while (n >>= 1) { ++r; }
+        return r;
+    }
+
+    static size_type _ceil2(size_type n) noexcept
+    {
+        size_type r = 1;
+        while (r < n) { r <<= 1; }
+        return r;
+    }
+
+    size_type _capacity() const noexcept { return _slots.size(); }
+    size_type _segments() const noexcept { return _count.size(); }
+    size_type _segment_size() const noexcept { return size_type{1} << _shift; }
+
+    size_type _rank(size_type slot) const noexcept
+    {
+        if (slot == _capacity()) { return _size; }
+        return _tree.prefix(slot >> _shift) + (slot & (_segment_size() - 1));
+    }
+
+    size_type _slot_at(size_type rank) const noexcept
+    {
+        if (rank >= _size) { return _capacity(); }
+        auto const [s, offset] = _tree.find(rank);
+        return (s << _shift) + offset;
+    }
+
+    size_type _first_slot_from(size_type s) const noexcept
+    {
+        for (; s < _segments(); ++s)
+        {
+            if (_count[s] != 0) { return s << _shift; }
+        }
+        return _capacity();
+    }
+
+    size_type _next_slot(size_type slot) const noexcept
+    {
+        auto const s = slot >> _shift;
+        if ((slot & (_segment_size() - 1)) + 1 < _count[s]) { return slot + 1; }
+        return _first_slot_from(s + 1);
+    }
+
+    size_type _prev_slot(size_type slot) const noexcept
+    {
+        if (slot != _capacity() && (slot & (_segment_size() - 1)) != 0) { return slot - 1; }
+        auto s = slot >> _shift;
+        while (_count[--s] == 0) { }
+        return (s << _shift) + _count[s] - 1;
+    }
+
+    size_type _advance(size_type slot, difference_type n) const noexcept
+    {
+        if (slot != _capacity())
+        {
+            auto const offset = static_cast<difference_type>(slot & (_segment_size() - 1));
+            if (0 <= offset + n && offset + n < static_cast<difference_type>(_count[slot >> _shift])) { return static_cast<size_type>(static_cast<difference_type>(slot) + n); }
+        }
+        return _slot_at(static_cast<size_type>(static_cast<difference_type>(_rank(slot)) + n));
+    }
+
+    difference_type _distance(size_type from, size_type to) const noexcept
+    {
+        if (from != _capacity() && to != _capacity() && (from >> _shift) == (to >> _shift))
+        {
+            return static_cast<difference_type>(to) - static_cast<difference_type>(from);
+        }
+        return static_cast<difference_type>(_rank(to)) - static_cast<difference_type>(_rank(from));
+    }
+
+    // Moves elements of segments [first, last) into `out`.
+    template <typename Out>
+    void _collect(size_type first, size_type last, Out& out)
+    {
+        for (auto s = first; s < last; ++s)
+        {
+            auto const base = _slots.begin() + static_cast<difference_type>(s << _shift);
+            std::move(base, base + static_cast<difference_type>(_count[s]), std::back_inserter(out));
+        }
+    }
+
+    // Spreads `elements` evenly over segments [first, first + n).
+    template <typename Elements>
+    void _spread(size_type first, size_type n, Elements& elements)
+    {
+        auto itr = elements.begin();
+        auto const m = static_cast<size_type>(elements.size());
+        for (size_type j = 0; j < n; ++j)
+        {
+            auto const count = m / n + (j < m % n);
+            auto const s = first + j;
+            std::move(itr, itr + static_cast<difference_type>(count), _slots.begin() + static_cast<difference_type>(s << _shift));
+            itr += static_cast<difference_type>(count);
+            _tree.add(s, static_cast<difference_type>(count) - static_cast<difference_type>(_count[s]));
+            _count[s] = count;
+        }
+    }
+
+    // Lays out `elements` over new storage with density of about 1/2.
+    void _rebuild(std::vector<T, Allocator>& elements)
+    {
+        _size = elements.size();
+        if (_size == 0)
+        {
+            _slots.clear();
+            _count.clear();
+            _tree.clear();
+            _shift = 0;
+            return;
+        }
+
+        auto const capacity = std::max(_ceil2(_size * 2), _min_capacity);
+        _shift = _log2(_ceil2(std::max<size_type>(8, _log2(capacity))));
+        _slots.clear();
+        _slots.resize(capacity);
+        _count.assign(capacity >> _shift, 0);
+        _tree.assign(_count.size(), [](size_type) { return size_type{0}; });
+        _spread(0, _count.size(), elements);
+    }
+
+    std::vector<T, Allocator> _elements(size_type reserved = 0)
+    {
+        std::vector<T, Allocator> elements(_slots.get_allocator());
+        elements.reserve(_size + reserved);
+        _collect(0, _segments(), elements);
+        return elements;
+    }
+
+    iterator _insert_value(const_iterator pos, T&& value)
+    {
+        auto const rank = _rank(pos._slot);
+        if (_size == 0)
+        {
+            std::vector<T, Allocator> elements(_slots.get_allocator());
+            elements.push_back(std::move(value));
+            _rebuild(elements);
+            return iterator{this, _slot_at(rank)};
+        }
+
+        // The end is next to the last element in its segment.
+        auto const last = pos._slot == _capacity() ? _prev_slot(pos._slot) : pos._slot;
+        auto const s = last >> _shift;
+        auto const offset = (last & (_segment_size() - 1)) + (pos._slot == _capacity());
+        auto const slot = (s << _shift) + offset;
+
+        if (_count[s] < _segment_size())
+        {
+            auto const base = _slots.begin() + static_cast<difference_type>(s << _shift);
+            std::move_backward(base + static_cast<difference_type>(offset), base + static_cast<difference_type>(_count[s]), base + static_cast<difference_type>(_count[s] + 1));
+            base[static_cast<difference_type>(offset)] = std::move(value);
+            ++_count[s];
+            _tree.add(s, 1);
+            ++_size;
+            return iterator{this, slot};
+        }
+
+        // Upper density threshold goes from 1 at the segment to 3/4 at the root.
+        auto const height = _log2(_segments());
+        for (size_type h = 1; h <= height; ++h)
+        {
+            auto const first = (s >> h) << h;
+            auto const n = size_type{1} << h;
+            auto const m = _tree.prefix(first + n) - _tree.prefix(first) + 1;
+            if (m * 4 * height <= (n << _shift) * (4 * height - h))
+            {
+                std::vector<T, Allocator> elements(_slots.get_allocator());
+                elements.reserve(m);
+                _collect(first, s, elements);
+                auto const base = _slots.begin() + static_cast<difference_type>(s << _shift);
+                std::move(base, base + static_cast<difference_type>(offset), std::back_inserter(elements));
+                elements.push_back(std::move(value));
+                std::move(base + static_cast<difference_type>(offset), base + static_cast<difference_type>(_count[s]), std::back_inserter(elements));
+                _collect(s + 1, first + n, elements);
+                _spread(first, n, elements);
+                ++_size;
+                return iterator{this, _slot_at(rank)};
+            }
+        }
+
+        auto elements = _elements(1);
+        elements.insert(elements.begin() + static_cast<difference_type>(rank), std::move(value));
+        _rebuild(elements);
+        return iterator{this, _slot_at(rank)};
+    }
+
+    void _erase_at(size_type slot)
+    {
+        auto const s = slot >> _shift;
+        auto const offset = slot & (_segment_size() - 1);
+        auto const base = _slots.begin() + static_cast<difference_type>(s << _shift);
+        std::move(base + static_cast<difference_type>(offset) + 1, base + static_cast<difference_type>(_count[s]), base + static_cast<difference_type>(offset));
+        --_count[s];
+        _tree.add(s, -1);
+        --_size;
+    }
+
+    // Shrinks the storage once the density drops below 1/8.
+    void _shrink_sparse()
+    {
+        if (_size * 8 < _capacity() && _capacity() > _min_capacity)
+        {
+            auto elements = _elements();
+            _rebuild(elements);
+        }
+    }
+
+public:
+    packed_memory_array() = default;
+
+    explicit packed_memory_array(allocator_type const& alloc) : _slots(alloc), _count(_size_allocator(alloc)), _tree(_size_allocator(alloc)) { }
+
+    packed_memory_array(size_type count, value_type const& value, allocator_type const& alloc = allocator_type())
+      : packed_memory_array(alloc)
+    {
+        assign(count, value);
+    }
+
+    explicit packed_memory_array(size_type count, allocator_type const& alloc = allocator_type())
+      : packed_memory_array(alloc)
+    {
+        std::vector<T, Allocator> elements(count, alloc);
+        _rebuild(elements);
+    }
+
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    packed_memory_array(InputIterator first, InputIterator last, allocator_type const& alloc = allocator_type())
+      : packed_memory_array(alloc)
+    {
+        assign(first, last);
+    }
+
+    packed_memory_array(packed_memory_array const&) = default;
+
+    packed_memory_array(packed_memory_array const& other, allocator_type const& alloc)
+      : _slots(other._slots, alloc), _count(other._count, _size_allocator(alloc)), _tree(other._tree, alloc), _size{other._size}, _shift{other._shift} { }
+
+    packed_memory_array(packed_memory_array&& other) noexcept
+      : _slots(std::move(other._slots)), _count(std::move(other._count)), _tree(std::move(other._tree)), _size{std::exchange(other._size, 0)}, _shift{std::exchange(other._shift, 0)} { }
+
+    packed_memory_array(packed_memory_array&& other, allocator_type const& alloc)
+      : _slots(std::move(other._slots), alloc), _count(std::move(other._count), _size_allocator(alloc)), _tree(std::move(other._tree), alloc), _size{std::exchange(other._size, 0)}, _shift{std::exchange(other._shift, 0)}
+    {
+        other.clear();
+    }
+
+    packed_memory_array(std::initializer_list<value_type> init, allocator_type const& alloc = allocator_type())
+      : packed_memory_array(init.begin(), init.end(), alloc) { }
+
+    packed_memory_array& operator=(packed_memory_array const&) = default;
+
+    packed_memory_array& operator=(packed_memory_array&& other) noexcept(std::is_nothrow_move_assignable_v<std::vector<T, Allocator>>)
+    {
+        _slots = std::move(other._slots);
+        _count = std::move(other._count);
+        _tree = std::move(other._tree);
+        _size = std::exchange(other._size, 0);
+        _shift = std::exchange(other._shift, 0);
+        other.clear();
+        return *this;
+    }
+
+    packed_memory_array& operator=(std::initializer_list<value_type> ilist)
+    {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    void assign(size_type count, value_type const& value)
+    {
+        std::vector<T, Allocator> elements(count, value, _slots.get_allocator());
+        _rebuild(elements);
+    }
+
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    void assign(InputIterator first, InputIterator last)
+    {
+        std::vector<T, Allocator> elements(first, last, _slots.get_allocator());
+        _rebuild(elements);
+    }
+
+    void assign(std::initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    allocator_type get_allocator() const noexcept { return _slots.get_allocator(); }
+
+    reference at(size_type pos)
+    {
+        if (!(pos < size())) { throw std::out_of_range{"packed_memory_array::at"}; }
+        return operator[](pos);
+    }
+
+    const_reference at(size_type pos) const { return const_cast<packed_memory_array*>(this)->at(pos); }
+
+    reference operator[](size_type pos) { return _slots[_slot_at(pos)]; }
+    const_reference operator[](size_type pos) const { return _slots[_slot_at(pos)]; }
+
+    reference front() { return *begin(); }
+    const_reference front() const { return *begin(); }
+    reference back() { return *std::prev(end()); }
+    const_reference back() const { return *std::prev(end()); }
+
+    iterator begin() noexcept { return iterator{this, _first_slot_from(0)}; }
+    const_iterator begin() const noexcept { return const_iterator{this, _first_slot_from(0)}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator{this, _capacity()}; }
+    const_iterator end() const noexcept { return const_iterator{this, _capacity()}; }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+    size_type max_size() const noexcept { return _slots.max_size() / 2; }
+
+    // Number of slots including gaps.
+    size_type capacity() const noexcept { return _capacity(); }
+
+    void shrink_to_fit()
+    {
+        auto elements = _elements();
+        _rebuild(elements);
+    }
+
+    void clear() noexcept
+    {
+        _slots.clear();
+        _count.clear();
+        _tree.clear();
+        _size = 0;
+        _shift = 0;
+    }
+
+    iterator insert(const_iterator pos, value_type const& value) { return _insert_value(pos, value_type(value)); }
+
+    iterator insert(const_iterator pos, value_type&& value) { return _insert_value(pos, std::move(value)); }
+
+    iterator insert(const_iterator pos, size_type count, value_type const& value)
+    {
+        std::vector<T, Allocator> values(count, value, _slots.get_allocator());
+        return insert(pos, std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+    }
+
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    iterator insert(const_iterator pos, InputIterator first, InputIterator last)
+    {
+        auto const rank = _rank(pos._slot);
+        auto elements = _elements();
+        elements.insert(elements.begin() + static_cast<difference_type>(rank), first, last);
+        _rebuild(elements);
+        return iterator{this, _slot_at(rank)};
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) { return _insert_value(pos, value_type(std::forward<Args>(args)...)); }
+
+    iterator erase(const_iterator pos)
+    {
+        auto const rank = _rank(pos._slot);
+        _erase_at(pos._slot);
+        _shrink_sparse();
+        return iterator{this, _slot_at(rank)};
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto const rank = _rank(first._slot);
+        auto const n = static_cast<size_type>(last - first);
+        if (n == 0) { return iterator{this, first._slot}; }
+
+        // Each erasure shifts a segment, which is cheaper than moving every element for a few elements.
+        if (n << _shift < _size)
+        {
+            for (size_type i = 0; i < n; ++i) { _erase_at(_slot_at(rank)); }
+        }
+        else
+        {
+            auto elements = _elements();
+            elements.erase(elements.begin() + static_cast<difference_type>(rank), elements.begin() + static_cast<difference_type>(rank + n));
+            _rebuild(elements);
+        }
+        _shrink_sparse();
+        return iterator{this, _slot_at(rank)};
+    }
+
+    void push_back(value_type const& value) { insert(end(), value); }
+
+    void push_back(value_type&& value) { insert(end(), std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+    void pop_back() { erase(std::prev(end())); }
+
+    void swap(packed_memory_array& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value || std::allocator_traits<Allocator>::is_always_equal::value)
+    {
+        using std::swap;
+        swap(_slots, other._slots);
+        swap(_count, other._count);
+        swap(_tree, other._tree);
+        swap(_size, other._size);
+        swap(_shift, other._shift);
+    }
+};
+
+template <typename T, typename Allocator>
+bool operator==(packed_memory_array<T, Allocator> const& lhs, packed_memory_array<T, Allocator> const& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Allocator>
+bool operator!=(packed_memory_array<T, Allocator> const& lhs, packed_memory_array<T, Allocator> const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Allocator>
+bool operator<(packed_memory_array<T, Allocator> const& lhs, packed_memory_array<T, Allocator> const& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Allocator>
+bool operator<=(packed_memory_array<T, Allocator> const& lhs, packed_memory_array<T, Allocator> const& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Allocator>
+bool operator>(packed_memory_array<T, Allocator> const& lhs, packed_memory_array<T, Allocator> const& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename T, typename Allocator>
+bool operator>=(packed_memory_array<T, Allocator> const& lhs, packed_memory_array<T, Allocator> const& rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <typename T, typename Allocator>
+void swap(packed_memory_array<T, Allocator>& lhs, packed_memory_array<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <typename T, typename Allocator, typename Pred>
+typename packed_memory_array<T, Allocator>::size_type erase_if(packed_memory_array<T, Allocator>& c, Pred pred)
+{
+    auto itr = std::remove_if(c.begin(), c.end(), std::move(pred));
+    auto r = std::distance(itr, c.end());
+    c.erase(itr, c.end());
+    return r;
+}
+
+} // namespace flat_map
@@ -0,0 +1,194 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "flat_map/chunked_vector.hpp"
+#include "flat_map/flat_map.hpp"
+
+TEST_CASE("chunked_vector", "[container]")
+{
+    SECTION("construct")
+    {
+        flat_map::chunked_vector<int> c = {1, 2, 3, 4, 5};
+        REQUIRE(c.size() == 5);
+        REQUIRE(c.capacity() == decltype(c)::block_capacity);
+        REQUIRE(c.front() == 1);
+        REQUIRE(c.back() == 5);
+        REQUIRE(c[3] == 4);
+        REQUIRE_FALSE(c == flat_map::chunked_vector<int>(5, 0));
+        REQUIRE(std::distance(c.begin(), c.end()) == 5);
+        REQUIRE(std::equal(c.rbegin(), c.rend(), std::vector<int>{5, 4, 3, 2, 1}.begin()));
+
+        flat_map::chunked_vector<int> empty;
+        REQUIRE(empty.empty());
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(c.begin() != empty.begin());
+    }
+
+    SECTION("iterator")
+    {
+        // Small blocks, to step over many blocks.
+        flat_map::chunked_vector<int, std::allocator<int>, 8 * sizeof(int)> c(100, 0);
+        std::iota(c.begin(), c.end(), 0);
+
+        auto itr = c.begin();
+        REQUIRE(*(itr + 42) == 42);
+        REQUIRE((itr + 42) - itr == 42);
+        REQUIRE(itr[99] == 99);
+        REQUIRE(itr + 100 == c.end());
+        REQUIRE(c.end() - 100 == itr);
+        REQUIRE(itr < c.cend());
+        REQUIRE(*std::lower_bound(c.begin(), c.end(), 57) == 57);
+    }
+
+    SECTION("copy")
+    {
+        flat_map::chunked_vector<int, std::allocator<int>, 8 * sizeof(int)> c(100, 0);
+        for (auto i = 0; i < 100; ++i) { c.insert(std::next(c.begin(), i * 2), i); }
+
+        // Copy keeps the blocks, even though it isn't laid out as same as range insertion.
+        auto copied = c;
+        decltype(c) assigned;
+        assigned = c;
+        decltype(c) moved(decltype(c)(c), c.get_allocator());
+        for (auto const* other : {&copied, &assigned, &moved})
+        {
+            REQUIRE(*other == c);
+            REQUIRE(other->segment_count() == c.segment_count());
+            for (std::size_t i = 0; i < c.segment_count(); ++i) { REQUIRE(other->segment_size(i) == c.segment_size(i)); }
+        }
+    }
+
+    SECTION("random modification")
+    {
+        std::mt19937 rng{};
+        flat_map::chunked_vector<std::string, std::allocator<std::string>, 16 * sizeof(std::string)> c;
+        std::vector<std::string> ref;
+
+        for (auto i = 0; i < 20000; ++i)
+        {
+            auto const op = rng() % 100;
+            if (op < 70 || ref.empty())
+            {
+                auto const pos = rng() % (ref.size() + 1);
+                auto const value = std::to_string(i);
+                auto itr = c.insert(std::next(c.begin(), pos), value);
+                ref.insert(std::next(ref.begin(), pos), value);
+                REQUIRE(*itr == value);
+                REQUIRE(static_cast<std::size_t>(std::distance(c.begin(), itr)) == pos);
+            }
+            else if (op < 96)
+            {
+                auto const pos = rng() % ref.size();
+                auto itr = c.erase(std::next(c.begin(), pos));
+                ref.erase(std::next(ref.begin(), pos));
+                REQUIRE(static_cast<std::size_t>(std::distance(c.begin(), itr)) == pos);
+            }
+            else if (op < 99)
+            {
+                auto const pos = rng() % (ref.size() + 1);
+                std::vector<std::string> values(rng() % (3 * decltype(c)::block_capacity));
+                for (auto& value : values) { value = std::to_string(rng()); }
+                auto itr = c.insert(std::next(c.begin(), pos), values.begin(), values.end());
+                ref.insert(std::next(ref.begin(), pos), values.begin(), values.end());
+                REQUIRE(static_cast<std::size_t>(std::distance(c.begin(), itr)) == pos);
+            }
+            else
+            {
+                auto const first = rng() % ref.size();
+                auto const last = first + rng() % (ref.size() - first + 1);
+                c.erase(std::next(c.begin(), first), std::next(c.begin(), last));
+                ref.erase(std::next(ref.begin(), first), std::next(ref.begin(), last));
+            }
+            REQUIRE(c.size() == ref.size());
+            if (i % 1000 == 0) { REQUIRE(std::equal(c.begin(), c.end(), ref.begin(), ref.end())); }
+        }
+        REQUIRE(std::equal(c.begin(), c.end(), ref.begin(), ref.end()));
+        REQUIRE(std::equal(c.rbegin(), c.rend(), ref.rbegin(), ref.rend()));
+        REQUIRE(c.capacity() <= ref.size() * 4 + decltype(c)::block_capacity);
+
+        auto const copy = ref;
+        c.insert(std::next(c.begin(), 3), copy.begin(), copy.end());
+        ref.insert(std::next(ref.begin(), 3), copy.begin(), copy.end());
+        REQUIRE(std::equal(c.begin(), c.end(), ref.begin(), ref.end()));
+
+        c.clear();
+        REQUIRE(c.empty());
+        REQUIRE(c.begin() == c.end());
+    }
+}
+
+TEST_CASE("chunked_vector as the container of flat_map", "[container]")
+{
+    // Small blocks, to split and merge many blocks.
+    using map_type = flat_map::flat_map<int, int, std::less<int>, flat_map::chunked_vector<std::pair<int, int>, std::allocator<std::pair<int, int>>, 4 * sizeof(std::pair<int, int>)>>;
+
+    std::mt19937 rng{};
+    map_type fm;
+    std::map<int, int> ref;
+
+    for (auto i = 0; i < 5000; ++i)
+    {
+        auto const key = static_cast<int>(rng() % 256);
+        switch (rng() % 8)
+        {
+        case 0:
+        case 1:
+        case 2:
+            REQUIRE(fm.insert({key, i}).second == ref.insert({key, i}).second);
+            break;
+        case 3:
+        case 4:
+            REQUIRE(fm.erase(key) == ref.erase(key));
+            break;
+        case 5:
+            if (auto itr = fm.lower_bound(key); itr != fm.end())
+            {
+                ref.erase(itr->first);
+                fm.erase(itr);
+            }
+            break;
+        case 6:
+            fm.insert({{key, i}, {key / 2, i}, {key * 2 % 256, i}});
+            ref.insert({{key, i}, {key / 2, i}, {key * 2 % 256, i}});
+            break;
+        case 7:
+            switch (rng() % 4)
+            {
+            case 0:
+                fm = map_type(fm);
+                break;
+            case 1:
+                erase_if(fm, [&](auto const& value) { return value.first % 16 == key % 16; });
+                for (auto itr = ref.begin(); itr != ref.end();) { itr = itr->first % 16 == key % 16 ? ref.erase(itr) : std::next(itr); }
+                break;
+            case 2:
+                fm.base().push_back({256 + i, i});
+                ref.emplace(256 + i, i);
+                break;
+            case 3:
+                fm.freeze();
+                break;
+            }
+            break;
+        }
+
+        REQUIRE(fm.size() == ref.size());
+        for (auto k = -1; k <= 256; k += 3)
+        {
+            auto const itr = fm.lower_bound(k);
+            auto const expected = ref.lower_bound(k);
+            REQUIRE((itr == fm.end() ? expected == ref.end() : expected != ref.end() && itr->first == expected->first));
+            REQUIRE(fm.contains(k) == (ref.count(k) != 0));
+        }
+    }
+    REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), ref.end(), [](auto const& lhs, auto const& rhs) { return lhs.first == rhs.first && lhs.second == rhs.second; }));
+}
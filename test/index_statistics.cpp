@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "flat_map/flat_set.hpp"
+#include "flat_map/index.hpp"
+
+template <typename Index>
+using indexed_set = flat_map::flat_set<int, std::less<int>, std::vector<int>, Index>;
+
+TEST_CASE("memoized statistics", "[index]")
+{
+    indexed_set<flat_map::index::memoized<16>> fs = {1, 3, 5, 7, 9};
+
+    REQUIRE(fs.contains(5));
+    REQUIRE(fs.lookup_index().hits() == 0);
+    REQUIRE(fs.lookup_index().misses() == 1);
+
+    REQUIRE(fs.contains(5));
+    REQUIRE(*fs.find(5) == 5);
+    REQUIRE(fs.lookup_index().hits() == 2);
+    REQUIRE(fs.lookup_index().misses() == 1);
+
+    fs.insert(4); // looks 4 up
+    REQUIRE(fs.contains(5));
+    REQUIRE(fs.lookup_index().hits() == 2);
+    REQUIRE(fs.lookup_index().misses() == 3);
+    REQUIRE(std::distance(fs.begin(), fs.find(5)) == 3);
+}
+
+TEST_CASE("bloom statistics", "[index]")
+{
+    indexed_set<flat_map::index::bloom<>> fs;
+    for (auto i = 0; i < 1000; ++i) { fs.insert(fs.end(), i * 2); }
+
+    fs.freeze();
+    REQUIRE(fs.lookup_index().memory_usage() >= 1000 * 10 / 8);
+    REQUIRE(fs.lookup_index().false_positive_rate() > 0);
+    REQUIRE(fs.lookup_index().false_positive_rate() < 0.02);
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        REQUIRE(fs.contains(i * 2));
+        REQUIRE_FALSE(fs.contains(i * 2 + 1));
+        REQUIRE(fs.count(i * 2 + 1) == 0);
+    }
+
+    fs.insert(1);
+    REQUIRE(fs.contains(1));
+    fs.erase(2);
+    REQUIRE_FALSE(fs.contains(2));
+}
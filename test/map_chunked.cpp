@@ -0,0 +1,17 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include "flat_map/flat_map.hpp"
+#include "flat_map/chunked_vector.hpp"
+
+// Small blocks, to search over many segments.
+template <typename T>
+using CONTAINER = flat_map::chunked_vector<T, std::allocator<T>, 4 * sizeof(T)>;
+
+#define FLAT_MAP 1
+#define MULTI_CONTAINER 0
+#include "test_case/basic.ipp"
+#include "test_case/stateful_comparison.ipp"
+#include "test_case/std.ipp"
+#include "test_case/map_only.ipp"
+#include "test_case/move_only.ipp"
@@ -0,0 +1,271 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "flat_map/flat_map.hpp"
+#include "flat_map/flat_multimap.hpp"
+#include "flat_map/index.hpp"
+
+template <typename Index>
+using delta_map = flat_map::flat_map<int, int, std::less<int>, std::vector<std::pair<int, int>>, Index>;
+
+template <typename Index>
+using delta_multimap = flat_map::flat_multimap<int, int, std::less<int>, std::vector<std::pair<int, int>>, Index>;
+
+template <typename C, typename R>
+static void check_lookup(C const& fm, R const& ref)
+{
+    REQUIRE(fm.size() == ref.size());
+    for (int key = -1; key <= 64; ++key)
+    {
+        REQUIRE(fm.count(key) == ref.count(key));
+        REQUIRE(fm.contains(key) == (ref.count(key) != 0));
+        auto itr = fm.find(key);
+        REQUIRE((itr == fm.end() ? ref.count(key) == 0 : itr->first == key));
+    }
+}
+
+template <typename C, typename R>
+static void check_order(C const& fm, R const& ref)
+{
+    REQUIRE(fm.size() == ref.size());
+    REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), ref.end(), [](auto const& lhs, auto const& rhs) { return lhs.first == rhs.first && lhs.second == rhs.second; }));
+    for (int key = -1; key <= 64; ++key)
+    {
+        REQUIRE(std::distance(fm.begin(), fm.lower_bound(key)) == std::distance(ref.begin(), ref.lower_bound(key)));
+        REQUIRE(std::distance(fm.begin(), fm.upper_bound(key)) == std::distance(ref.begin(), ref.upper_bound(key)));
+    }
+}
+
+template <typename Index>
+static void check_unique()
+{
+    std::mt19937 rng{};
+    delta_map<Index> fm;
+    std::map<int, int> ref;
+
+    for (auto i = 0; i < 2000; ++i)
+    {
+        auto const key = static_cast<int>(rng() % 64);
+        auto const value = static_cast<int>(rng() % 100);
+        switch (rng() % 7)
+        {
+        case 0:
+        {
+            auto [itr, inserted] = fm.insert({key, value});
+            REQUIRE(inserted == ref.insert({key, value}).second);
+            REQUIRE(itr->first == key);
+            break;
+        }
+        case 1:
+            REQUIRE(fm.try_emplace(key, value).second == ref.try_emplace(key, value).second);
+            break;
+        case 2:
+            fm[key] = value;
+            ref[key] = value;
+            break;
+        case 3:
+            REQUIRE(fm.emplace_hint(fm.find(value % 64), key, value)->first == key);
+            ref.emplace(key, value);
+            break;
+        case 4:
+            REQUIRE(fm.erase(key) == ref.erase(key));
+            break;
+        case 5:
+            if (auto itr = fm.find(key); itr != fm.end())
+            {
+                fm.erase(itr);
+                ref.erase(key);
+            }
+            break;
+        case 6:
+            fm.insert({{key, value}, {value % 64, key}, {key, key}});
+            ref.insert({{key, value}, {value % 64, key}, {key, key}});
+            break;
+        }
+        check_lookup(fm, ref);
+        if (i % 97 == 0) { check_order(fm, ref); }
+    }
+    check_order(fm, ref);
+}
+
+template <typename Index>
+static void check_multi()
+{
+    std::mt19937 rng{};
+    delta_multimap<Index> fm;
+    std::multimap<int, int> ref;
+
+    for (auto i = 0; i < 2000; ++i)
+    {
+        auto const key = static_cast<int>(rng() % 64);
+        auto const value = i;
+        switch (rng() % 5)
+        {
+        case 0:
+        case 1:
+            REQUIRE(fm.insert({key, value})->second == value);
+            ref.insert({key, value});
+            break;
+        case 2:
+            REQUIRE(fm.emplace_hint(fm.end(), key, value)->second == value);
+            ref.emplace(key, value);
+            break;
+        case 3:
+            if (auto itr = fm.find(key); itr != fm.end())
+            {
+                fm.erase(itr);
+                ref.erase(ref.find(key));
+            }
+            break;
+        case 4:
+            fm.insert({{key, value}, {value % 64, value}, {key, value}});
+            ref.insert({{key, value}, {value % 64, value}, {key, value}});
+            break;
+        }
+        check_lookup(fm, ref);
+        if (i % 97 == 0) { check_order(fm, ref); }
+    }
+    check_order(fm, ref);
+}
+
+TEST_CASE("delta buffered insertion", "[index]")
+{
+    SECTION("unique")
+    {
+        check_unique<flat_map::index::delta<8>>();
+        check_unique<flat_map::index::delta<>>();
+    }
+
+    SECTION("multi")
+    {
+        check_multi<flat_map::index::delta<8>>();
+        check_multi<flat_map::index::delta<>>();
+    }
+
+    SECTION("ascending")
+    {
+        delta_map<flat_map::index::delta<8>> fm;
+        delta_multimap<flat_map::index::delta<8>> fmm;
+        for (int key = 0; key < 100; ++key)
+        {
+            fm.emplace(key, 0);
+            fmm.emplace(key / 2, key);
+            REQUIRE(fm.size() == static_cast<std::size_t>(key + 1));
+            REQUIRE(fm.contains(key));
+            REQUIRE(fmm.count(key / 2) == static_cast<std::size_t>(key % 2 + 1));
+        }
+    }
+
+    SECTION("buffer")
+    {
+        delta_map<flat_map::index::delta<4>> fm;
+        fm.insert({{5, 0}, {1, 0}, {3, 0}, {1, 1}});
+        REQUIRE(fm.lookup_index().pending() == 3);
+        REQUIRE(fm.contains(1));
+        REQUIRE(fm.count(3) == 1);
+        REQUIRE(fm.lookup_index().pending() == 3);
+
+        fm.insert({{2, 0}, {3, 1}});
+        REQUIRE(fm.lookup_index().pending() == 0);
+        fm.insert({{4, 0}});
+        REQUIRE(fm.lookup_index().pending() == 1);
+
+        auto itr = fm.begin();
+        REQUIRE(fm.lookup_index().pending() == 0);
+        for (auto key : {1, 2, 3, 4, 5}) { REQUIRE((itr++)->first == key); }
+
+        fm.insert({{0, 0}});
+        fm.freeze();
+        REQUIRE(fm.lookup_index().pending() == 0);
+        REQUIRE(fm.begin()->first == 0);
+    }
+
+    SECTION("find then end")
+    {
+        delta_map<flat_map::index::delta<64>> fm;
+        delta_multimap<flat_map::index::delta<64>> fmm;
+        fm.insert({{10, 1000}, {20, 2000}, {30, 3000}, {40, 4000}});
+        fmm.insert({{10, 1000}, {20, 2000}, {30, 3000}, {40, 4000}});
+        fm.freeze();
+        fmm.freeze();
+        fm.insert({{30, 3000}, {5, 500}, {25, 2500}, {15, 1500}});
+        fmm.insert({{30, 3000}, {5, 500}, {25, 2500}, {15, 1500}});
+        REQUIRE(fm.lookup_index().pending() == 3);
+        REQUIRE(fmm.lookup_index().pending() == 4);
+
+        for (auto key : {5, 15, 25, 40})
+        {
+            auto itr = fm.find(key);
+            REQUIRE(itr != fm.end());
+            REQUIRE(itr->first == key);
+            REQUIRE(itr->second == key * 100);
+        }
+        REQUIRE(fm.find(35) == fm.end());
+
+        auto itr = fmm.find(5);
+        REQUIRE(itr != fmm.end());
+        REQUIRE(itr->first == 5);
+        REQUIRE(itr == fmm.begin());
+    }
+
+    SECTION("insertion then begin")
+    {
+        delta_map<flat_map::index::delta<64>> fm;
+        delta_multimap<flat_map::index::delta<64>> fmm;
+        fm.insert({{10, 10}, {20, 20}, {30, 30}, {40, 40}, {50, 50}});
+        fmm.insert({{10, 10}, {20, 20}, {30, 30}, {40, 40}, {50, 50}});
+
+        auto itr = fm.insert({5, 5}).first;
+        fm.begin();
+        REQUIRE(itr->first == 5);
+
+        fm.insert({{45, 45}, {15, 15}});
+        itr = fm.try_emplace(25, 25).first;
+        REQUIRE(fm.cend() - itr == 5);
+        REQUIRE(itr->first == 25);
+
+        fm.insert({{35, 35}});
+        auto& value = fm[35];
+        fm.end();
+        REQUIRE(&value == &fm.find(35)->second);
+
+        fm.insert({{55, 55}});
+        itr = fm.emplace_hint(fm.end(), 1, 1);
+        REQUIRE(itr == fm.begin());
+
+        fmm.insert({{5, 5}, {25, 25}});
+        auto mitr = fmm.insert({25, 26});
+        fmm.begin();
+        REQUIRE(mitr->second == 26);
+        REQUIRE(std::prev(mitr)->second == 25);
+    }
+
+    SECTION("allocator-extended constructor")
+    {
+        using map_type = delta_map<flat_map::index::delta<64>>;
+        map_type fm;
+        fm.insert({{10, 10}, {20, 20}, {30, 30}, {40, 40}, {50, 50}});
+        fm.begin();
+        fm.insert({{5, 5}, {45, 45}});
+        REQUIRE(fm.lookup_index().pending() == 2);
+
+        std::map<int, int> const ref{{5, 5}, {10, 10}, {20, 20}, {30, 30}, {40, 40}, {45, 45}, {50, 50}};
+        map_type copied(fm, fm.get_allocator());
+        check_lookup(copied, ref);
+        check_order(copied, ref);
+
+        auto const alloc = fm.get_allocator();
+        map_type moved(std::move(fm), alloc);
+        check_lookup(moved, ref);
+        check_order(moved, ref);
+    }
+}
@@ -14,3 +14,4 @@ using CONTAINER = std::deque<T>;
 #include "test_case/stateful_comparison.ipp"
 #include "test_case/std.ipp"
 #include "test_case/map_only.ipp"
+#include "test_case/move_only.ipp"
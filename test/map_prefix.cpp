@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flat_map/flat_map.hpp"
+#include "flat_map/flat_multimap.hpp"
+#include "flat_map/index.hpp"
+
+template <typename Compare>
+using prefix_map = flat_map::flat_map<std::string, int, Compare, std::vector<std::pair<std::string, int>>, flat_map::index::prefix>;
+
+template <typename Compare>
+using prefix_multimap = flat_map::flat_multimap<std::string, int, Compare, std::vector<std::pair<std::string, int>>, flat_map::index::prefix>;
+
+static std::string random_string(std::mt19937& rng, std::string_view head, bool whole_head)
+{
+    static constexpr char chars[] = {'\0', '/', 'a', 'b', 'z', '\x7f', '\x80', '\xff'};
+    std::string s{whole_head ? head : head.substr(0, std::uniform_int_distribution<std::size_t>{0, head.size()}(rng))};
+    for (auto n = std::uniform_int_distribution<int>{0, 12}(rng); n > 0; --n) { s.push_back(chars[rng() % sizeof(chars)]); }
+    return s;
+}
+
+template <typename C, typename R>
+static void check_prefix_lookup(C const& fm, R const& ref, std::vector<std::string> const& probes)
+{
+    REQUIRE(fm.size() == ref.size());
+    for (auto const& key : probes)
+    {
+        REQUIRE(std::distance(fm.begin(), fm.lower_bound(key)) == std::distance(ref.begin(), ref.lower_bound(key)));
+        REQUIRE(std::distance(fm.begin(), fm.upper_bound(key)) == std::distance(ref.begin(), ref.upper_bound(key)));
+        REQUIRE(fm.count(key) == ref.count(key));
+    }
+}
+
+TEST_CASE("prefix lookup", "[index]")
+{
+    std::mt19937 rng{};
+    constexpr std::string_view head = "https://example.com/";
+
+    std::vector<std::pair<std::string, int>> v;
+    std::vector<std::string> probes = {"", "h", "https://", std::string{head}, "i", std::string(9, '\0')};
+    for (auto i = 0; i < 500; ++i)
+    {
+        v.emplace_back(random_string(rng, head, true), i);
+        probes.push_back(random_string(rng, head, false));
+        probes.push_back(v.back().first);
+    }
+
+    SECTION("unique")
+    {
+        prefix_map<std::less<std::string>> fm(v.begin(), v.end());
+        std::map<std::string, int> ref(v.begin(), v.end());
+        check_prefix_lookup(fm, ref, probes);
+
+        // within the head, then out of it
+        fm.emplace(std::string{head} + "zzz", 0);
+        ref.emplace(std::string{head} + "zzz", 0);
+        check_prefix_lookup(fm, ref, probes);
+        fm.emplace("ftp://", 0);
+        ref.emplace("ftp://", 0);
+        check_prefix_lookup(fm, ref, probes);
+
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto const& key = probes[rng() % probes.size()];
+            REQUIRE(fm.erase(key) == ref.erase(key));
+            REQUIRE_FALSE(fm.contains(key));
+        }
+        check_prefix_lookup(fm, ref, probes);
+    }
+
+    SECTION("multi")
+    {
+        prefix_multimap<std::less<std::string>> fm(v.begin(), v.end());
+        std::multimap<std::string, int> ref(v.begin(), v.end());
+        fm.insert(v.begin(), v.end());
+        ref.insert(v.begin(), v.end());
+        check_prefix_lookup(fm, ref, probes);
+
+        fm.freeze();
+        fm.emplace_hint(fm.begin(), v.front());
+        ref.insert(v.front());
+        check_prefix_lookup(fm, ref, probes);
+    }
+
+    SECTION("erase_if")
+    {
+        prefix_map<std::less<std::string>> fm(v.begin(), v.end());
+        std::map<std::string, int> ref(v.begin(), v.end());
+        fm.freeze();
+
+        std::size_t count = 0;
+        for (auto itr = ref.begin(); itr != ref.end();)
+        {
+            if (itr->second % 2 != 0) { itr = ref.erase(itr); ++count; }
+            else { ++itr; }
+        }
+        REQUIRE(erase_if(fm, [](auto const& value) { return value.second % 2 != 0; }) == count);
+        for (auto const& [key, value] : ref) { REQUIRE(fm.find(key) != fm.end()); }
+        check_prefix_lookup(fm, ref, probes);
+    }
+
+    SECTION("transparent")
+    {
+        prefix_map<std::less<>> fm(v.begin(), v.end());
+        std::map<std::string, int, std::less<>> ref(v.begin(), v.end());
+        for (auto const& key : probes)
+        {
+            std::string_view const sv = key;
+            REQUIRE(std::distance(fm.begin(), fm.lower_bound(sv)) == std::distance(ref.begin(), ref.lower_bound(sv)));
+            REQUIRE(fm.contains(sv) == (ref.count(sv) != 0));
+        }
+
+        fm.emplace("https://example.com/index.html", 0);
+        REQUIRE(fm.contains("https://example.com/index.html"));
+        REQUIRE_FALSE(fm.contains("https://example.com/index.htm"));
+    }
+}
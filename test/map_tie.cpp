@@ -16,3 +16,4 @@ using CONTAINER = flat_map::tied_sequence<std::vector<std::tuple_element_t<0, T>
 #include "test_case/stateful_comparison.ipp"
 #include "test_case/std.ipp"
 #include "test_case/map_only.ipp"
+#include "test_case/index.ipp"
@@ -15,3 +15,5 @@ using CONTAINER = std::vector<T>;
 #include "test_case/stateful_comparison.ipp"
 #include "test_case/std.ipp"
 #include "test_case/map_only.ipp"
+#include "test_case/move_only.ipp"
+#include "test_case/index.ipp"
@@ -14,3 +14,4 @@ using CONTAINER = std::vector<T>;
 #include "test_case/deduction_guide.ipp"
 #include "test_case/stateful_comparison.ipp"
 #include "test_case/std.ipp"
+#include "test_case/index.ipp"
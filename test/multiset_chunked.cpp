@@ -0,0 +1,15 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include "flat_map/flat_multiset.hpp"
+#include "flat_map/chunked_vector.hpp"
+
+// Small blocks, to search over many segments.
+template <typename T>
+using CONTAINER = flat_map::chunked_vector<T, std::allocator<T>, 4 * sizeof(T)>;
+
+#define FLAT_MAP 0
+#define MULTI_CONTAINER 1
+#include "test_case/basic.ipp"
+#include "test_case/stateful_comparison.ipp"
+#include "test_case/std.ipp"
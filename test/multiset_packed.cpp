@@ -0,0 +1,14 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include "flat_map/flat_multiset.hpp"
+#include "flat_map/packed_memory_array.hpp"
+
+template <typename T>
+using CONTAINER = flat_map::packed_memory_array<T>;
+
+#define FLAT_MAP 0
+#define MULTI_CONTAINER 1
+#include "test_case/basic.ipp"
+#include "test_case/stateful_comparison.ipp"
+#include "test_case/std.ipp"
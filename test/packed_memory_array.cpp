@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "flat_map/packed_memory_array.hpp"
+
+TEST_CASE("packed_memory_array", "[container]")
+{
+    SECTION("construct")
+    {
+        flat_map::packed_memory_array<int> c = {1, 2, 3, 4, 5};
+        REQUIRE(c.size() == 5);
+        REQUIRE(c.capacity() >= 10);
+        REQUIRE(c.front() == 1);
+        REQUIRE(c.back() == 5);
+        REQUIRE(c[3] == 4);
+        REQUIRE_FALSE(c == flat_map::packed_memory_array<int>(5, 0));
+        REQUIRE(std::distance(c.begin(), c.end()) == 5);
+        REQUIRE(std::equal(c.rbegin(), c.rend(), std::vector<int>{5, 4, 3, 2, 1}.begin()));
+
+        flat_map::packed_memory_array<int> empty;
+        REQUIRE(empty.empty());
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(c.begin() != empty.begin());
+    }
+
+    SECTION("iterator")
+    {
+        flat_map::packed_memory_array<int> c(100, 0);
+        std::iota(c.begin(), c.end(), 0);
+
+        auto itr = c.begin();
+        REQUIRE(*(itr + 42) == 42);
+        REQUIRE((itr + 42) - itr == 42);
+        REQUIRE(itr[99] == 99);
+        REQUIRE(itr + 100 == c.end());
+        REQUIRE(c.end() - 100 == itr);
+        REQUIRE(itr < c.cend());
+        REQUIRE(*std::lower_bound(c.begin(), c.end(), 57) == 57);
+    }
+
+    SECTION("random modification")
+    {
+        std::mt19937 rng{};
+        flat_map::packed_memory_array<std::string> c;
+        std::vector<std::string> ref;
+
+        for (auto i = 0; i < 20000; ++i)
+        {
+            auto const op = rng() % 100;
+            if (op < 70 || ref.empty())
+            {
+                auto const pos = rng() % (ref.size() + 1);
+                auto const value = std::to_string(i);
+                auto itr = c.insert(std::next(c.begin(), pos), value);
+                ref.insert(std::next(ref.begin(), pos), value);
+                REQUIRE(*itr == value);
+                REQUIRE(static_cast<std::size_t>(std::distance(c.begin(), itr)) == pos);
+            }
+            else if (op < 99)
+            {
+                auto const pos = rng() % ref.size();
+                auto itr = c.erase(std::next(c.begin(), pos));
+                ref.erase(std::next(ref.begin(), pos));
+                REQUIRE(static_cast<std::size_t>(std::distance(c.begin(), itr)) == pos);
+            }
+            else
+            {
+                auto const first = rng() % ref.size();
+                auto const last = first + rng() % (ref.size() - first + 1);
+                c.erase(std::next(c.begin(), first), std::next(c.begin(), last));
+                ref.erase(std::next(ref.begin(), first), std::next(ref.begin(), last));
+            }
+            REQUIRE(c.size() == ref.size());
+            if (i % 1000 == 0) { REQUIRE(std::equal(c.begin(), c.end(), ref.begin(), ref.end())); }
+        }
+        REQUIRE(std::equal(c.begin(), c.end(), ref.begin(), ref.end()));
+        REQUIRE(std::equal(c.rbegin(), c.rend(), ref.rbegin(), ref.rend()));
+        REQUIRE(c.capacity() < ref.size() * 8);
+
+        auto const copy = ref;
+        c.insert(std::next(c.begin(), 3), copy.begin(), copy.end());
+        ref.insert(std::next(ref.begin(), 3), copy.begin(), copy.end());
+        REQUIRE(std::equal(c.begin(), c.end(), ref.begin(), ref.end()));
+
+        c.clear();
+        REQUIRE(c.empty());
+        REQUIRE(c.begin() == c.end());
+    }
+}
@@ -1,9 +1,11 @@
 // Copyright (c) 2021,2023 Kohei Takahashi
 // This software is released under the MIT License, see LICENSE.
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <functional>
 #include <iterator>
+#include <string>
 #include <vector>
 
 #include "config.hpp"
@@ -203,6 +205,128 @@ TEST_CASE("construction", "[construction]")
         REQUIRE(*itr++ == MAKE_PAIR(6, 7));
         REQUIRE(itr == move.end());
     }
+
+    SECTION("large construction")
+    {
+        // Enough elements to be sorted by radix sort, which should keep the order of equivalent elements.
+        auto check = [](auto key_of, auto comp)
+        {
+            using K = decltype(key_of(0));
+            std::vector<decltype(MAKE_PAIR(K{}, 0))> v;
+#if MULTI_CONTAINER
+            STD_MULTI_CONTAINER<K, int, decltype(comp)> ref;
+#else
+            STD_CONTAINER<K, int, decltype(comp)> ref;
+#endif
+            for (auto i = 0; i < 5000; ++i)
+            {
+                auto const key = key_of((i * 7919) % 2003 - 1001);
+                v.push_back(MAKE_PAIR(key, i));
+                ref.insert(MAKE_STD_PAIR(key, i));
+            }
+            FLAT_CONTAINER<K, int, decltype(comp)> fm(v.begin(), v.end());
+
+            auto same = [](auto const& lhs, auto const& rhs)
+            {
+#if FLAT_MAP
+                return std::get<0>(lhs) == rhs.first && std::get<1>(lhs) == rhs.second;
+#else
+                return lhs == rhs;
+#endif
+            };
+            REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), ref.end(), same));
+        };
+        check([](int i) { return i; }, std::less<int>{});
+        check([](int i) { return i; }, std::greater<int>{});
+        check([](int i) { return static_cast<unsigned long long>(i) << 40; }, std::less<unsigned long long>{});
+        check([](int i) { return i % 5 == 0 ? -0.0 : i * 0.5; }, std::less<double>{});
+    }
+
+    SECTION("sorted runs construction")
+    {
+        // Ascending and descending runs with duplicates, which are merged keeping the order of equivalent elements.
+        std::vector<decltype(MAKE_PAIR(0, 0))> v;
+#if MULTI_CONTAINER
+        STD_MULTI_CONTAINER<int, int> ref;
+#else
+        STD_CONTAINER<int, int> ref;
+#endif
+        for (auto run = 0; run < 7; ++run)
+        {
+            for (auto i = 0; i < 300 * (run + 1); ++i)
+            {
+                auto const key = run % 2 == 0 ? i / 2 + run * 10 : 1000 - i / 3;
+                auto const index = static_cast<int>(v.size());
+                v.push_back(MAKE_PAIR(key, index));
+                ref.insert(MAKE_STD_PAIR(key, index));
+            }
+        }
+        FLAT_CONTAINER<int, int> fm(v.begin(), v.end());
+
+        auto same = [](auto const& lhs, auto const& rhs)
+        {
+#if FLAT_MAP
+            return std::get<0>(lhs) == rhs.first && std::get<1>(lhs) == rhs.second;
+#else
+            return lhs == rhs;
+#endif
+        };
+        REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), ref.end(), same));
+    }
+}
+
+TEST_CASE("parallel construction", "[construction]")
+{
+    // Enough elements to be split for 4 threads.
+    std::vector<decltype(MAKE_PAIR(0, 0))> v;
+    for (auto i = 0; i < 100000; ++i) { v.push_back(MAKE_PAIR((i * 7919) % 30011, i)); }
+    auto const half = std::next(v.begin(), 60000);
+    auto const policy = flat_map::parallel_policy{4};
+
+    SECTION("iter construction")
+    {
+        FLAT_CONTAINER<int, int> fm(policy, v.begin(), v.end());
+        REQUIRE(fm == FLAT_CONTAINER<int, int>(v.begin(), v.end()));
+
+        FLAT_CONTAINER<int, int, std::greater<>> rev(policy, v.begin(), v.end());
+        REQUIRE(rev == FLAT_CONTAINER<int, int, std::greater<>>(v.begin(), v.end()));
+    }
+
+    SECTION("pre constructed container")
+    {
+        using container_type = CONTAINER<PAIR<int, int>>;
+        FLAT_CONTAINER<int, int> fm(policy, flat_map::range_order::no_ordered, container_type(v.begin(), v.end()));
+        REQUIRE(fm == FLAT_CONTAINER<int, int>(flat_map::range_order::no_ordered, container_type(v.begin(), v.end())));
+
+        auto sorted = v;
+        std::stable_sort(sorted.begin(), sorted.end(), [](auto const& lhs, auto const& rhs) { return FIRST(lhs) < FIRST(rhs); });
+        FLAT_CONTAINER<int, int> fs(policy, flat_map::range_order::sorted, container_type(sorted.begin(), sorted.end()));
+        REQUIRE(fs == fm);
+    }
+
+    SECTION("range insertion")
+    {
+        FLAT_CONTAINER<int, int> fm(v.begin(), half);
+        auto ref = fm;
+        fm.insert(policy, flat_map::range_order::no_ordered, half, v.end());
+        ref.insert(flat_map::range_order::no_ordered, half, v.end());
+        REQUIRE(fm == ref);
+    }
+
+    SECTION("string keys")
+    {
+        // Moved-from strings differ from the others, unlike integers.
+        std::vector<decltype(MAKE_PAIR(std::string{}, 0))> s;
+        for (auto i = 0; i < 100000; ++i) { s.push_back(MAKE_PAIR("key/" + std::to_string((i * 7919) % 30011), i)); }
+        FLAT_CONTAINER<std::string, int> fm(policy, s.begin(), s.end());
+        REQUIRE(fm == FLAT_CONTAINER<std::string, int>(s.begin(), s.end()));
+
+        FLAT_CONTAINER<std::string, int> fi(s.begin(), std::next(s.begin(), 60000));
+        auto ref = fi;
+        fi.insert(policy, flat_map::range_order::no_ordered, std::next(s.begin(), 60000), s.end());
+        ref.insert(flat_map::range_order::no_ordered, std::next(s.begin(), 60000), s.end());
+        REQUIRE(fi == ref);
+    }
 }
 
 TEST_CASE("assignment", "[assignment]")
@@ -654,6 +778,175 @@ TEST_CASE("accessor with transparent", "[accessor]")
     }
 }
 
+TEST_CASE("batch lookup", "[accessor]")
+{
+    FLAT_CONTAINER<int, int> fm =
+    {
+        MAKE_PAIR(0, 1),
+        MAKE_PAIR(2, 3),
+        MAKE_PAIR(2, 9),
+        MAKE_PAIR(4, 5),
+        MAKE_PAIR(6, 7),
+    };
+    auto const& cfm = fm;
+
+    std::vector<int> keys = {4, -1, 2, 3, 7, 0, 6, 5, 1, 2, 4, 6, 0, 3, 9, 8, 2, 5};
+
+    SECTION("lower_bound_many")
+    {
+        std::vector<decltype(fm.begin())> itrs;
+        fm.lower_bound_many(keys.begin(), keys.end(), std::back_inserter(itrs));
+        REQUIRE(itrs.size() == keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(itrs[i] == fm.lower_bound(keys[i])); }
+
+        std::vector<decltype(cfm.begin())> citrs;
+        cfm.lower_bound_many(keys.begin(), keys.end(), std::back_inserter(citrs));
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(citrs[i] == cfm.lower_bound(keys[i])); }
+    }
+
+    SECTION("find_many")
+    {
+        std::vector<decltype(fm.begin())> itrs;
+        fm.find_many(keys.begin(), keys.end(), std::back_inserter(itrs));
+        REQUIRE(itrs.size() == keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(itrs[i] == fm.find(keys[i])); }
+
+        std::vector<decltype(cfm.begin())> citrs;
+        cfm.find_many(keys.begin(), keys.end(), std::back_inserter(citrs));
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(citrs[i] == cfm.find(keys[i])); }
+    }
+
+    SECTION("contains_many")
+    {
+        bool found[18];
+        auto last = cfm.contains_many(keys.begin(), keys.end(), found);
+        REQUIRE(last == std::end(found));
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(found[i] == fm.contains(keys[i])); }
+    }
+
+    SECTION("sorted keys")
+    {
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<decltype(fm.begin())> itrs;
+        fm.lower_bound_many(flat_map::range_order::sorted, keys.begin(), keys.end(), std::back_inserter(itrs));
+        REQUIRE(itrs.size() == keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(itrs[i] == fm.lower_bound(keys[i])); }
+
+        std::vector<decltype(cfm.begin())> citrs;
+        cfm.find_many(flat_map::range_order::sorted, keys.begin(), keys.end(), std::back_inserter(citrs));
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(citrs[i] == cfm.find(keys[i])); }
+
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        std::vector<bool> found;
+        cfm.contains_many(flat_map::range_order::unique_sorted, keys.begin(), keys.end(), std::back_inserter(found));
+        for (std::size_t i = 0; i < keys.size(); ++i) { REQUIRE(found[i] == fm.contains(keys[i])); }
+    }
+
+    SECTION("large")
+    {
+        std::vector<decltype(MAKE_PAIR(0, 0))> v;
+        for (auto i = 0; i < (1 << 17); ++i) { v.push_back(MAKE_PAIR(i * 2, i)); }
+        FLAT_CONTAINER<int, int> large(v.begin(), v.end());
+
+        std::vector<int> many;
+        for (auto i = -1; i < (1 << 18); i += 13) { many.push_back(i); }
+        std::vector<bool> found;
+        large.contains_many(many.begin(), many.end(), std::back_inserter(found));
+        REQUIRE(found.size() == many.size());
+        for (std::size_t i = 0; i < many.size(); ++i) { REQUIRE(found[i] == (many[i] >= 0 && many[i] % 2 == 0)); }
+    }
+
+    SECTION("empty")
+    {
+        FLAT_CONTAINER<int, int> empty;
+        std::vector<bool> found;
+        empty.contains_many(keys.begin(), keys.end(), std::back_inserter(found));
+        REQUIRE(found == std::vector<bool>(keys.size(), false));
+    }
+}
+
+TEST_CASE("batch lookup with transparent", "[accessor]")
+{
+    FLAT_CONTAINER<int, int, std::less<>> fm =
+    {
+        MAKE_PAIR(0, 1),
+        MAKE_PAIR(2, 3),
+        MAKE_PAIR(2, 9),
+        MAKE_PAIR(4, 5),
+        MAKE_PAIR(6, 7),
+    };
+
+    std::vector<wrap<int>> keys = {2, 3, 6, -1, 7};
+
+    std::vector<decltype(fm.begin())> itrs;
+    fm.find_many(keys.begin(), keys.end(), std::back_inserter(itrs));
+    REQUIRE(itrs.size() == 5);
+    REQUIRE(std::distance(fm.begin(), itrs[0]) == 1);
+    REQUIRE(itrs[1] == fm.end());
+    REQUIRE(std::next(itrs[2]) == fm.end());
+    REQUIRE(itrs[3] == fm.end());
+    REQUIRE(itrs[4] == fm.end());
+
+    std::vector<bool> found;
+    fm.contains_many(keys.begin(), keys.end(), std::back_inserter(found));
+    REQUIRE(found == std::vector<bool>{true, false, true, false, false});
+}
+
+TEST_CASE("cursor", "[accessor]")
+{
+    FLAT_CONTAINER<int, int> fm;
+    for (int key = 0; key < 200; key += 2) { fm.insert(fm.end(), MAKE_PAIR(key, key)); }
+    fm.insert(MAKE_PAIR(100, 1));
+
+    SECTION("monotone seek")
+    {
+        auto cursor = fm.make_cursor();
+        for (int key = -1; key <= 201; ++key)
+        {
+            REQUIRE(cursor.seek(key) == fm.lower_bound(key));
+            REQUIRE(cursor.find(key) == fm.find(key));
+        }
+        for (int key = 201; key >= -1; key -= 3)
+        {
+            REQUIRE(cursor.seek(key) == fm.lower_bound(key));
+        }
+    }
+
+    SECTION("arbitrary seek")
+    {
+        auto cursor = fm.make_cursor();
+        for (int key : {150, 3, 3, 199, 0, 100, 101, 42, 250, -5, 77})
+        {
+            REQUIRE(cursor.seek(key) == fm.lower_bound(key));
+            REQUIRE(cursor.find(key) == fm.find(key));
+        }
+    }
+
+    SECTION("seek after mutation")
+    {
+        auto cursor = fm.make_cursor();
+        REQUIRE(cursor.seek(150) == fm.lower_bound(150));
+        fm.erase(fm.begin(), fm.lower_bound(120));
+        REQUIRE(cursor.seek(150) == fm.lower_bound(150));
+        fm.insert(MAKE_PAIR(151, 0));
+        REQUIRE(cursor.find(151) == fm.find(151));
+        fm.clear();
+        REQUIRE(cursor.seek(151) == fm.end());
+    }
+
+    SECTION("const cursor")
+    {
+        auto const& cfm = fm;
+        auto cursor = cfm.make_cursor();
+        for (int key = 0; key <= 200; key += 7)
+        {
+            REQUIRE(cursor.seek(key) == cfm.lower_bound(key));
+            REQUIRE(cursor.find(key) == cfm.find(key));
+        }
+    }
+}
+
 TEST_CASE("insertion", "[insertion]")
 {
     SECTION("insert")
@@ -818,6 +1111,34 @@ TEST_CASE("insertion", "[insertion]")
         REQUIRE(itr == fm.end());
     }
 
+    SECTION("insert with distant hint")
+    {
+        FLAT_CONTAINER<int, int> fm;
+        STD_MULTI_CONTAINER<int, int> ref;
+        for (int key = 0; key < 100; key += 2)
+        {
+            fm.insert(fm.end(), MAKE_PAIR(key, 0));
+            ref.insert(MAKE_STD_PAIR(key, 0));
+        }
+
+        for (int key = -1; key <= 100; key += 3)
+        {
+            for (auto hint = 0u; hint <= fm.size(); hint += 7)
+            {
+                auto itr = fm.insert(std::next(fm.begin(), hint), MAKE_PAIR(key, 1));
+                REQUIRE(FIRST(*itr) == key);
+#if MULTI_CONTAINER
+                ref.insert(MAKE_STD_PAIR(key, 1));
+#else
+                if (ref.count(key) == 0) { ref.insert(MAKE_STD_PAIR(key, 1)); }
+#endif
+            }
+        }
+
+        REQUIRE(fm.size() == ref.size());
+        REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), [](auto const& lhs, auto const& rhs) { return FIRST(lhs) == FIRST(rhs); }));
+    }
+
     SECTION("insert range")
     {
         std::vector v =
@@ -990,6 +1311,39 @@ TEST_CASE("insertion", "[insertion]")
 #endif
         REQUIRE(itr == fm.end());
     }
+
+    SECTION("insert unordered range")
+    {
+        // Duplicates in the range, collisions with the elements, and keys before, between, and after the elements.
+        std::vector<decltype(MAKE_PAIR(0, 0))> v;
+        for (auto i = 0; i < 1000; ++i) { v.push_back(MAKE_PAIR(1000 + i * 2, i)); }
+        FLAT_CONTAINER<int, int> fm(v.begin(), v.end());
+#if MULTI_CONTAINER
+        STD_MULTI_CONTAINER<int, int> ref;
+#else
+        STD_CONTAINER<int, int> ref;
+#endif
+        for (auto i = 0; i < 1000; ++i) { ref.insert(MAKE_STD_PAIR(1000 + i * 2, i)); }
+
+        v.clear();
+        for (auto i = 0; i < 600; ++i)
+        {
+            auto const key = (i * 7919) % 4001;
+            v.push_back(MAKE_PAIR(key, -i));
+            ref.insert(MAKE_STD_PAIR(key, -i));
+        }
+        fm.insert(flat_map::range_order::no_ordered, v.begin(), v.end());
+
+        auto same = [](auto const& lhs, auto const& rhs)
+        {
+#if FLAT_MAP
+            return std::get<0>(lhs) == rhs.first && std::get<1>(lhs) == rhs.second;
+#else
+            return lhs == rhs;
+#endif
+        };
+        REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), ref.end(), same));
+    }
 }
 
 TEST_CASE("erase", "[erase]")
@@ -1079,6 +1433,56 @@ TEST_CASE("erase", "[erase]")
         REQUIRE(*itr++ == MAKE_PAIR(6, 7));
         REQUIRE(itr == fm.end());
     }
+
+    SECTION("erase keys")
+    {
+        FLAT_CONTAINER<int, int> fm =
+        {
+            MAKE_PAIR(0, 1),
+            MAKE_PAIR(2, 3),
+            MAKE_PAIR(2, 8),
+            MAKE_PAIR(4, 5),
+            MAKE_PAIR(6, 7),
+        };
+
+        std::vector<int> keys = {6, 2, 5, 2, -1, 0};
+#if MULTI_CONTAINER
+        REQUIRE(fm.erase_keys(keys.begin(), keys.end()) == 4);
+#else
+        REQUIRE(fm.erase_keys(keys.begin(), keys.end()) == 3);
+#endif
+        REQUIRE(fm.size() == 1);
+        REQUIRE(*fm.begin() == MAKE_PAIR(4, 5));
+        REQUIRE(fm.erase_keys(keys.begin(), keys.end()) == 0);
+        REQUIRE(fm.size() == 1);
+    }
+
+    SECTION("erase sorted keys")
+    {
+        FLAT_CONTAINER<int, int> fm =
+        {
+            MAKE_PAIR(0, 1),
+            MAKE_PAIR(2, 3),
+            MAKE_PAIR(2, 8),
+            MAKE_PAIR(4, 5),
+            MAKE_PAIR(6, 7),
+        };
+
+        std::vector<int> keys = {1, 2, 4, 7};
+#if MULTI_CONTAINER
+        REQUIRE(fm.erase_keys(flat_map::range_order::sorted, keys.begin(), keys.end()) == 3);
+#else
+        REQUIRE(fm.erase_keys(flat_map::range_order::sorted, keys.begin(), keys.end()) == 2);
+#endif
+        REQUIRE(fm.size() == 2);
+
+        auto itr = fm.begin();
+        REQUIRE(*itr++ == MAKE_PAIR(0, 1));
+        REQUIRE(*itr++ == MAKE_PAIR(6, 7));
+        REQUIRE(itr == fm.end());
+        REQUIRE(fm.find(6) != fm.end());
+        REQUIRE(fm.find(4) == fm.end());
+    }
 }
 
 TEST_CASE("node", "[insertion][erase]")
@@ -1537,6 +1941,81 @@ TEST_CASE("erase_if", "[erase_if]")
     REQUIRE(itr == fm.end());
 }
 
+struct three_way_int
+{
+    using is_three_way = void;
+    int operator()(int lhs, int rhs) const { return (lhs > rhs) - (lhs < rhs); }
+};
+
+TEST_CASE("three-way comparator", "[comparator]")
+{
+    FLAT_CONTAINER<int, int, three_way_int> fm = {MAKE_PAIR(6, 0), MAKE_PAIR(2, 1), MAKE_PAIR(4, 2), MAKE_PAIR(2, 3), MAKE_PAIR(0, 4), MAKE_PAIR(6, 5), MAKE_PAIR(8, 6)};
+#if MULTI_CONTAINER
+    STD_MULTI_CONTAINER<int, int> ref =
+#else
+    STD_CONTAINER<int, int> ref =
+#endif
+        {MAKE_STD_PAIR(6, 0), MAKE_STD_PAIR(2, 1), MAKE_STD_PAIR(4, 2), MAKE_STD_PAIR(2, 3), MAKE_STD_PAIR(0, 4), MAKE_STD_PAIR(6, 5), MAKE_STD_PAIR(8, 6)};
+
+    auto check = [&]
+    {
+        REQUIRE(fm.size() == ref.size());
+        REQUIRE(std::equal(fm.begin(), fm.end(), ref.begin(), [](auto const& lhs, auto const& rhs) { return FIRST(lhs) == FIRST(rhs); }));
+        for (int key = -1; key <= 10; ++key)
+        {
+            REQUIRE(std::distance(fm.begin(), fm.lower_bound(key)) == std::distance(ref.begin(), ref.lower_bound(key)));
+            REQUIRE(std::distance(fm.begin(), fm.upper_bound(key)) == std::distance(ref.begin(), ref.upper_bound(key)));
+            REQUIRE(fm.count(key) == ref.count(key));
+            REQUIRE(fm.contains(key) == (ref.count(key) != 0));
+            auto itr = fm.find(key);
+            REQUIRE((itr == fm.end() ? ref.count(key) == 0 : FIRST(*itr) == key));
+        }
+    };
+
+    SECTION("lookup")
+    {
+        check();
+        REQUIRE(fm.value_comp()(MAKE_PAIR(0, 1), MAKE_PAIR(2, 0)));
+        REQUIRE_FALSE(fm.value_comp()(MAKE_PAIR(2, 0), MAKE_PAIR(2, 1)));
+    }
+
+    SECTION("hinted insertion")
+    {
+        for (int key = -1; key <= 10; ++key)
+        {
+            for (auto hint = 0u; hint <= fm.size(); hint += 2)
+            {
+                fm.insert(std::next(fm.begin(), hint), MAKE_PAIR(key, 0));
+                ref.insert(MAKE_STD_PAIR(key, 0));
+            }
+        }
+        check();
+    }
+
+    SECTION("erase")
+    {
+        REQUIRE(fm.erase(2) == ref.erase(2));
+        REQUIRE(fm.erase(3) == ref.erase(3));
+        check();
+    }
+
+    SECTION("merge")
+    {
+        FLAT_CONTAINER<int, int, three_way_int> other = {MAKE_PAIR(1, 7), MAKE_PAIR(4, 8), MAKE_PAIR(9, 9), MAKE_PAIR(9, 10)};
+        fm.merge(other);
+        ref.insert({MAKE_STD_PAIR(1, 7), MAKE_STD_PAIR(4, 8), MAKE_STD_PAIR(9, 9), MAKE_STD_PAIR(9, 10)});
+        check();
+    }
+
+    SECTION("range insertion")
+    {
+        std::vector w = {MAKE_PAIR(5, 0), MAKE_PAIR(3, 0), MAKE_PAIR(5, 1), MAKE_PAIR(0, 0)};
+        fm.insert(w.begin(), w.end());
+        ref.insert({MAKE_STD_PAIR(5, 0), MAKE_STD_PAIR(3, 0), MAKE_STD_PAIR(5, 1), MAKE_STD_PAIR(0, 0)});
+        check();
+    }
+}
+
 TEST_CASE("comparison", "[comparison]")
 {
     SECTION("traditional comparator")
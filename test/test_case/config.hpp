@@ -84,14 +84,21 @@ using STD_MULTI_CONTAINER = std::multiset<Key, Compare>;
 #   define FLAT_CONTAINER_KEY FLAT_UNIQ_CONTAINER_KEY
 #endif
 
+// INDEX is given by the build to run the same fixture with a lookup index.
+#ifdef INDEX
+#   include "flat_map/index.hpp"
+#else
+#   define INDEX flat_map::index::none
+#endif
+
 template <typename Key, typename T, typename Compare = std::less<Key>>
-using FLAT_CONTAINER = FLAT_CONTAINER_KEY<PAIR_PARAM(Key, T), Compare, CONTAINER<PAIR<Key, T>>>;
+using FLAT_CONTAINER = FLAT_CONTAINER_KEY<PAIR_PARAM(Key, T), Compare, CONTAINER<PAIR<Key, T>>, INDEX>;
 
 template <typename Key, typename T, typename Compare = std::less<Key>>
-using FLAT_UNIQ_CONTAINER = FLAT_UNIQ_CONTAINER_KEY<PAIR_PARAM(Key, T), Compare, CONTAINER<PAIR<Key, T>>>;
+using FLAT_UNIQ_CONTAINER = FLAT_UNIQ_CONTAINER_KEY<PAIR_PARAM(Key, T), Compare, CONTAINER<PAIR<Key, T>>, INDEX>;
 
 template <typename Key, typename T, typename Compare = std::less<Key>>
-using FLAT_MULTI_CONTAINER = FLAT_MULTI_CONTAINER_KEY<PAIR_PARAM(Key, T), Compare, CONTAINER<PAIR<Key, T>>>;
+using FLAT_MULTI_CONTAINER = FLAT_MULTI_CONTAINER_KEY<PAIR_PARAM(Key, T), Compare, CONTAINER<PAIR<Key, T>>, INDEX>;
 
 template <typename T1, typename T2>
 auto MAKE_PAIR(T1 t1, [[maybe_unused]] T2 t2)
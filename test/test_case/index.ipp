@@ -0,0 +1,147 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "config.hpp"
+
+#if MULTI_CONTAINER
+using index_reference = std::multiset<int>;
+#else
+using index_reference = std::set<int>;
+#endif
+
+template <typename C>
+static void check_indexed_lookup(C const& fm, index_reference const& ref)
+{
+    REQUIRE(fm.size() == ref.size());
+    for (auto key = -1; key <= 1000; ++key)
+    {
+        REQUIRE(std::distance(fm.begin(), fm.lower_bound(key)) == std::distance(ref.begin(), ref.lower_bound(key)));
+        REQUIRE(std::distance(fm.begin(), fm.upper_bound(key)) == std::distance(ref.begin(), ref.upper_bound(key)));
+        REQUIRE(fm.count(key) == ref.count(key));
+        REQUIRE(fm.contains(key) == (ref.count(key) != 0));
+    }
+}
+
+TEST_CASE("indexed lookup", "[index]")
+{
+    std::mt19937 rng{};
+    std::uniform_int_distribution<int> dist{0, 999};
+
+    std::vector<decltype(MAKE_PAIR(0, 0))> v;
+    index_reference ref;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto key = dist(rng);
+        v.push_back(MAKE_PAIR(key, i));
+        ref.insert(key);
+    }
+
+    FLAT_CONTAINER<int, int> fm(v.begin(), v.end());
+
+    SECTION("construction")
+    {
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("freeze")
+    {
+        fm.freeze();
+        check_indexed_lookup(fm, ref);
+
+        auto key = dist(rng);
+        fm.insert(MAKE_PAIR(key, 0));
+        ref.insert(key);
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("insert")
+    {
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto key = dist(rng);
+            fm.insert(MAKE_PAIR(key, i));
+            ref.insert(key);
+            REQUIRE(fm.contains(key));
+        }
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("insert with hint")
+    {
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto key = dist(rng);
+            fm.emplace_hint(fm.begin(), MAKE_PAIR(key, i));
+            ref.insert(key);
+            REQUIRE(fm.contains(key));
+        }
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("erase")
+    {
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto key = dist(rng);
+            fm.erase(key);
+            ref.erase(key);
+            REQUIRE_FALSE(fm.contains(key));
+        }
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("insert range")
+    {
+        fm.insert(v.begin(), std::next(v.begin(), 100));
+        for (auto itr = v.begin(); itr != std::next(v.begin(), 100); ++itr)
+        {
+            ref.insert(FIRST(*itr));
+        }
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("merge")
+    {
+        FLAT_CONTAINER<int, int> other;
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto key = dist(rng);
+            other.insert(MAKE_PAIR(key, i));
+            ref.insert(key);
+        }
+        fm.merge(other);
+        check_indexed_lookup(fm, ref);
+    }
+
+    SECTION("clear")
+    {
+        REQUIRE(fm.contains(FIRST(v.front())));
+        fm.clear();
+        check_indexed_lookup(fm, {});
+    }
+
+    SECTION("swap")
+    {
+        FLAT_CONTAINER<int, int> other = {MAKE_PAIR(3, 1)};
+        REQUIRE(other.contains(3));
+        fm.swap(other);
+        check_indexed_lookup(fm, {3});
+        check_indexed_lookup(other, ref);
+    }
+
+    SECTION("copy and move")
+    {
+        REQUIRE(fm.contains(FIRST(v.front())));
+        auto copied = fm;
+        check_indexed_lookup(copied, ref);
+        auto moved = std::move(copied);
+        check_indexed_lookup(moved, ref);
+    }
+}
@@ -2,6 +2,7 @@
 // This software is released under the MIT License, see LICENSE.
 
 #include <catch2/catch_test_macros.hpp>
+#include <functional>
 #include <iterator>
 #include <stdexcept>
 
@@ -195,6 +196,70 @@ TEST_CASE("insert or assign", "[insertion]")
     }
 }
 
+TEST_CASE("insert or combine", "[insertion]")
+{
+    FLAT_CONTAINER<int, int> fm =
+    {
+        MAKE_PAIR(0, 1),
+        MAKE_PAIR(2, 3),
+        MAKE_PAIR(4, 5),
+    };
+
+    // Folded in order of the existing value and the inserted values.
+    auto const append = [](int lhs, int rhs) { return lhs * 10 + rhs; };
+
+    SECTION("unordered range")
+    {
+        fm.insert_or_combine({
+            MAKE_PAIR(2, 4),
+            MAKE_PAIR(3, 1),
+            MAKE_PAIR(2, 5),
+            MAKE_PAIR(5, 1),
+            MAKE_PAIR(3, 2),
+            MAKE_PAIR(2, 6),
+        }, append);
+
+        auto itr = fm.begin();
+        REQUIRE(*itr++ == MAKE_PAIR(0, 1));
+        REQUIRE(*itr++ == MAKE_PAIR(2, 3456));
+        REQUIRE(*itr++ == MAKE_PAIR(3, 12));
+        REQUIRE(*itr++ == MAKE_PAIR(4, 5));
+        REQUIRE(*itr++ == MAKE_PAIR(5, 1));
+        REQUIRE(itr == fm.end());
+    }
+
+    SECTION("sorted range")
+    {
+        fm.insert_or_combine(flat_map::range_order::sorted, {
+            MAKE_PAIR(-1, 1),
+            MAKE_PAIR(0, 2),
+            MAKE_PAIR(0, 3),
+            MAKE_PAIR(4, 6),
+            MAKE_PAIR(9, 9),
+        }, append);
+
+        auto itr = fm.begin();
+        REQUIRE(*itr++ == MAKE_PAIR(-1, 1));
+        REQUIRE(*itr++ == MAKE_PAIR(0, 123));
+        REQUIRE(*itr++ == MAKE_PAIR(2, 3));
+        REQUIRE(*itr++ == MAKE_PAIR(4, 56));
+        REQUIRE(*itr++ == MAKE_PAIR(9, 9));
+        REQUIRE(itr == fm.end());
+    }
+
+    SECTION("sum into empty")
+    {
+        FLAT_CONTAINER<int, int> sum;
+        sum.insert_or_combine({}, std::plus<>{});
+        REQUIRE(sum.empty());
+
+        sum.insert_or_combine({MAKE_PAIR(1, 1), MAKE_PAIR(0, 1), MAKE_PAIR(1, 1)}, std::plus<>{});
+        REQUIRE(sum.size() == 2);
+        REQUIRE(sum.at(0) == 1);
+        REQUIRE(sum.at(1) == 2);
+    }
+}
+
 TEST_CASE("map emplace insertion", "[insertion]")
 {
     SECTION("try emplace")
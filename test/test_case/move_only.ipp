@@ -0,0 +1,27 @@
+// Copyright (c) 2026 Kohei Takahashi
+// This software is released under the MIT License, see LICENSE.
+
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "config.hpp"
+
+TEST_CASE("move only mapped type", "[construction]")
+{
+    // Neither copyable nor default constructible, which should be moved by sorting.
+    struct MoveOnly
+    {
+        std::unique_ptr<int> value;
+
+        explicit MoveOnly(int value) : value{std::make_unique<int>(value)} {}
+    };
+
+    std::vector<PAIR<int, MoveOnly>> v;
+    for (auto i = 0; i < 1000; ++i) { v.emplace_back((i * 7919) % 1000, MoveOnly{i}); }
+    FLAT_CONTAINER<int, MoveOnly> fm(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+
+    REQUIRE(fm.size() == 1000);
+    for (auto i = 0; i < 1000; ++i) { REQUIRE(*fm.at((i * 7919) % 1000).value == i); }
+}